@@ -0,0 +1,230 @@
+// Attacks.cpp
+// This file fills the attack tables declared in Attacks.h.
+// Sliding piece tables are indexed with "magic" multipliers. They were found once by the search below and are kept
+// as constants, so start-up only fills the tables. Building with -DSEARCH_MAGICS runs the search again instead and
+// prints the multipliers it finds, in the layout of the constants.
+
+#include "Attacks.h"
+
+#if defined(SEARCH_MAGICS)
+#include <cstdio>
+#endif
+
+Bitboard PawnAttacks[2][SQUARE_NB];
+Bitboard KnightAttacks[SQUARE_NB];
+Bitboard KingAttacks[SQUARE_NB];
+Bitboard BetweenBB[SQUARE_NB][SQUARE_NB];
+Bitboard LineBB[SQUARE_NB][SQUARE_NB];
+Magic RookMagics[SQUARE_NB];
+Magic BishopMagics[SQUARE_NB];
+
+// Shared storage for the attack sets of all squares. The sizes are the sums of 2^(relevant squares) over the board.
+static Bitboard RookTable[0x19000];
+static Bitboard BishopTable[0x1480];
+
+// Rank and file steps of the rook and bishop rays
+static const int RookDirections[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+static const int BishopDirections[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+// Returns the square reached from 'square' after moving by (rankStep, fileStep), or -1 if it is off the board
+static int offsetSquare(int square, int rankStep, int fileStep) {
+    int rank = rankOf(square) + rankStep;
+    int file = fileOf(square) + fileStep;
+    if (rank < 0 || rank > 7 || file < 0 || file > 7) {
+        return -1;
+    }
+    return rank * 8 + file;
+}
+
+// Computes the attacks of a sliding piece by walking each ray until the board edge or the first occupied square.
+// Only used while building the tables.
+static Bitboard slidingAttacks(int square, Bitboard occupied, const int directions[4][2]) {
+    Bitboard attacks = 0;
+    for (int d = 0; d < 4; ++d) {
+        int s = offsetSquare(square, directions[d][0], directions[d][1]);
+        while (s != -1) {
+            attacks |= squareBB(s);
+            if (occupied & squareBB(s)) {
+                break; // The ray is blocked by this piece
+            }
+            s = offsetSquare(s, directions[d][0], directions[d][1]);
+        }
+    }
+    return attacks;
+}
+
+#if !defined(__BMI2__)
+// Magic multipliers of each square, from a1 to h8
+static const uint64_t RookMagicNumbers[SQUARE_NB] = {
+    0x0A80004000801220ULL, 0x8040004010002008ULL, 0x2080200010008008ULL, 0x1100100008210004ULL,
+    0xC200209084020008ULL, 0x2100010004000208ULL, 0x0400081000822421ULL, 0x0200010422048844ULL,
+    0x0041800280400020ULL, 0x0001404010002000ULL, 0x2083004020010010ULL, 0x0000801000800804ULL,
+    0x1130808008000400ULL, 0x0021000900020400ULL, 0x4002808011000200ULL, 0x0802000102088464ULL,
+    0x8104248000400090ULL, 0x011000C000402000ULL, 0x6080808020001001ULL, 0x1010008010080080ULL,
+    0x0041010004080011ULL, 0x0000808004000200ULL, 0x0000040008100201ULL, 0x6002020000804401ULL,
+    0x4200400280048021ULL, 0x6000208100400100ULL, 0x2000104100200100ULL, 0x1208100080080084ULL,
+    0x0412000A00200410ULL, 0x8400020080800400ULL, 0x8684900400210228ULL, 0x0210004200010084ULL,
+    0x0840004080800034ULL, 0x0210004000402004ULL, 0x8C1081200C801000ULL, 0x8004841000800800ULL,
+    0x0080814802800400ULL, 0x000C000200808004ULL, 0x8000020804001001ULL, 0x0100010082000044ULL,
+    0x0001800040038021ULL, 0x2401201002444000ULL, 0x8548200100110040ULL, 0x0110040008004040ULL,
+    0x00A1000800050010ULL, 0x2801008400090002ULL, 0x0B28880201040050ULL, 0x2004008410420001ULL,
+    0x2102042084410200ULL, 0x2080201000400240ULL, 0x0001001020004100ULL, 0x0200081000210100ULL,
+    0x0008080080040080ULL, 0x0A02010408100200ULL, 0x1040800200010080ULL, 0x008C004899040200ULL,
+    0x0020850200244012ULL, 0x0020850200244012ULL, 0x0000102001040841ULL, 0x140900040A100021ULL,
+    0x000200282410A102ULL, 0x000200282410A102ULL, 0x000200282410A102ULL, 0x4048240043802106ULL,
+};
+static const uint64_t BishopMagicNumbers[SQUARE_NB] = {
+    0x40106000A1160020ULL, 0x0020010250810120ULL, 0x2010010220280081ULL, 0x002806004050C040ULL,
+    0x0002021018000000ULL, 0x2001112010000400ULL, 0x0881010120218080ULL, 0x1030820110010500ULL,
+    0xA000411101010100ULL, 0x9000200104608880ULL, 0x000C1000BA004888ULL, 0x0090244400850485ULL,
+    0x0200040504128140ULL, 0x308D010402400000ULL, 0x3000010092104040ULL, 0x0204002101101084ULL,
+    0x8040004990312210ULL, 0x0004801001020400ULL, 0x0008049002441820ULL, 0x2008805806024300ULL,
+    0x2004000200A20000ULL, 0x0002028020842010ULL, 0x2000C002080A2910ULL, 0x108200428A048200ULL,
+    0x0804200010608100ULL, 0xC281904120020200ULL, 0x109428020C080021ULL, 0x0040040042430020ULL,
+    0x2418840009802000ULL, 0x00B0204002080200ULL, 0x50A8006A0A022200ULL, 0x1011020011462080ULL,
+    0x0008600420501403ULL, 0xC2010109A8200804ULL, 0xC002050440100040ULL, 0x8000040400080211ULL,
+    0x09A0208400048020ULL, 0x0040808202050100ULL, 0x0608010100004840ULL, 0x0608010100004840ULL,
+    0x0009411040081000ULL, 0x1019009004001000ULL, 0x8440210040483800ULL, 0x4000084010400208ULL,
+    0x1030142704002A10ULL, 0x4190B01000200041ULL, 0x24108450A4045380ULL, 0x2108008104500202ULL,
+    0x0400841008040300ULL, 0x0000208410080100ULL, 0x681001008804000AULL, 0x042080C042120508ULL,
+    0x8018004005010005ULL, 0x2102042084410200ULL, 0x8052200204104828ULL, 0x4082103202004006ULL,
+    0x0001008044200440ULL, 0x0004C04410841000ULL, 0x2000500104011130ULL, 0x1A0C010011C20229ULL,
+    0x0044800112202200ULL, 0x0434804908100424ULL, 0x0300404822C08200ULL, 0x48081010008A2A80ULL,
+};
+#endif
+
+#if defined(SEARCH_MAGICS) && !defined(__BMI2__)
+// Xorshift pseudo-random generator used for the magic search. Fixed seeds keep start-up deterministic.
+static uint64_t nextRandom(uint64_t& state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 2685821657736338717ULL;
+}
+
+// Tries random sparse multipliers until one maps every relevant occupancy of the square to an index
+// without two occupancies with different attack sets sharing it, then stores the attack sets at those indices
+static void findMagic(Magic& m, int square, const Bitboard occupancies[], const Bitboard references[], int size) {
+    // Per-rank seeds that reach a working magic after few attempts
+    static const uint64_t seeds[8] = {728, 2985, 786, 2501, 2009, 2821, 1699, 255};
+    static int epoch[4096];
+    static int attempt = 0;
+    uint64_t seed = seeds[rankOf(square)];
+
+    for (int i = 0; i < size; ) {
+        do {
+            m.magic = nextRandom(seed) & nextRandom(seed) & nextRandom(seed);
+        } while (popCount((m.magic * m.mask) >> 56) < 6);
+
+        ++attempt;
+        for (i = 0; i < size; ++i) {
+            unsigned idx = m.index(occupancies[i]);
+            if (epoch[idx] < attempt) {
+                epoch[idx] = attempt;
+                m.attacks[idx] = references[i];
+            } else if (m.attacks[idx] != references[i]) {
+                break; // Destructive collision, try another multiplier
+            }
+        }
+    }
+}
+#endif
+
+// Builds the attack table of one sliding piece type
+static void initMagics(Bitboard table[], Magic magics[], const int directions[4][2], const uint64_t numbers[]) {
+    static Bitboard occupancies[4096];
+    static Bitboard references[4096];
+    Bitboard* attacks = table;
+    (void)numbers; // Unused with PEXT indices, which need no magic multiplier
+
+    for (int square = 0; square < SQUARE_NB; ++square) {
+        // Pieces on the board edges never block a ray, so they are left out of the relevant occupancy
+        Bitboard rankEdges = (RANK_1_BB | RANK_8_BB) & ~(RANK_1_BB << (8 * rankOf(square)));
+        Bitboard fileEdges = (FILE_A_BB | FILE_H_BB) & ~(FILE_A_BB << fileOf(square));
+
+        Magic& m = magics[square];
+        m.mask = slidingAttacks(square, 0, directions) & ~(rankEdges | fileEdges);
+        m.shift = 64 - popCount(m.mask);
+        m.attacks = attacks;
+
+        // Enumerate every subset of the mask (Carry-Rippler trick) together with its attack set
+        int size = 0;
+        Bitboard subset = 0;
+        do {
+            occupancies[size] = subset;
+            references[size] = slidingAttacks(square, subset, directions);
+            ++size;
+            subset = (subset - m.mask) & m.mask;
+        } while (subset);
+        attacks += size;
+
+#if defined(SEARCH_MAGICS) && !defined(__BMI2__)
+        findMagic(m, square, occupancies, references, size);
+        std::printf("0x%016llXULL,%s", (unsigned long long)m.magic, (square % 4 == 3) ? "\n" : " ");
+        continue;
+#elif !defined(__BMI2__)
+        m.magic = numbers[square];
+#endif
+        for (int i = 0; i < size; ++i) {
+            m.attacks[m.index(occupancies[i])] = references[i];
+        }
+    }
+}
+
+// Fills the non-sliding attack tables and the table of squares between two aligned squares
+static void initStepAttacks() {
+    const int knightSteps[8][2] = {{2, 1}, {2, -1}, {-2, 1}, {-2, -1}, {1, 2}, {1, -2}, {-1, 2}, {-1, -2}};
+    const int kingSteps[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+    for (int square = 0; square < SQUARE_NB; ++square) {
+        for (int i = 0; i < 8; ++i) {
+            int s = offsetSquare(square, knightSteps[i][0], knightSteps[i][1]);
+            if (s != -1) {
+                KnightAttacks[square] |= squareBB(s);
+            }
+            s = offsetSquare(square, kingSteps[i][0], kingSteps[i][1]);
+            if (s != -1) {
+                KingAttacks[square] |= squareBB(s);
+            }
+        }
+        // White pawns capture towards the 8th rank, black pawns towards the 1st rank
+        for (int fileStep = -1; fileStep <= 1; fileStep += 2) {
+            int s = offsetSquare(square, 1, fileStep);
+            if (s != -1) {
+                PawnAttacks[WHITE][square] |= squareBB(s);
+            }
+            s = offsetSquare(square, -1, fileStep);
+            if (s != -1) {
+                PawnAttacks[BLACK][square] |= squareBB(s);
+            }
+        }
+    }
+
+    for (int from = 0; from < SQUARE_NB; ++from) {
+        for (int to = 0; to < SQUARE_NB; ++to) {
+            if (rookAttacks(from, 0) & squareBB(to)) {
+                BetweenBB[from][to] = rookAttacks(from, squareBB(to)) & rookAttacks(to, squareBB(from));
+                LineBB[from][to] = (rookAttacks(from, 0) & rookAttacks(to, 0)) | squareBB(from) | squareBB(to);
+            } else if (bishopAttacks(from, 0) & squareBB(to)) {
+                BetweenBB[from][to] = bishopAttacks(from, squareBB(to)) & bishopAttacks(to, squareBB(from));
+                LineBB[from][to] = (bishopAttacks(from, 0) & bishopAttacks(to, 0)) | squareBB(from) | squareBB(to);
+            }
+        }
+    }
+}
+
+// Method to initialize all attack tables exactly once
+void initAttacks() {
+    static bool initialized = []() {
+#if !defined(__BMI2__)
+        initMagics(RookTable, RookMagics, RookDirections, RookMagicNumbers);
+        initMagics(BishopTable, BishopMagics, BishopDirections, BishopMagicNumbers);
+#else
+        initMagics(RookTable, RookMagics, RookDirections, nullptr);
+        initMagics(BishopTable, BishopMagics, BishopDirections, nullptr);
+#endif
+        initStepAttacks();
+        return true;
+    }();
+    (void)initialized;
+}
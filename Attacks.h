@@ -0,0 +1,100 @@
+// Attacks.h
+// This file declares the precomputed attack tables used to answer "which squares does this piece attack?" in constant time.
+// Knight, king and pawn attacks are looked up directly by square. Rook and bishop attacks depend on the occupied squares
+// and are looked up through magic bitboards, or through the PEXT instruction when the engine is built with BMI2 support (-mbmi2).
+
+#ifndef ATTACKS_H
+#define ATTACKS_H
+
+#include "Bitboard.h"
+#include "Color.h"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+// Magic holds the lookup data of a sliding piece (rook or bishop) on one square
+struct Magic {
+    Bitboard mask;      // Relevant occupancy squares, excluding the board edges
+    Bitboard magic;     // Magic multiplier mapping each relevant occupancy to a unique index
+    Bitboard* attacks;  // Pointer to the attack sets of this square in the shared attack table
+    unsigned shift;     // Right shift applied after the multiplication
+
+    // Computes the index of the attack set for the given occupancy
+    unsigned index(Bitboard occupied) const {
+#if defined(__BMI2__)
+        return unsigned(_pext_u64(occupied, mask));
+#else
+        return unsigned(((occupied & mask) * magic) >> shift);
+#endif
+    }
+};
+
+extern Bitboard PawnAttacks[2][SQUARE_NB];
+extern Bitboard KnightAttacks[SQUARE_NB];
+extern Bitboard KingAttacks[SQUARE_NB];
+extern Bitboard BetweenBB[SQUARE_NB][SQUARE_NB];
+extern Bitboard LineBB[SQUARE_NB][SQUARE_NB];
+extern Magic RookMagics[SQUARE_NB];
+extern Magic BishopMagics[SQUARE_NB];
+
+// Fills all attack tables. It is safe to call more than once; only the first call does the work.
+void initAttacks();
+
+// Returns the squares attacked by a pawn of the given color standing on 'square'
+inline Bitboard pawnAttacks(Color color, int square) {
+    return PawnAttacks[color][square];
+}
+
+// Returns the squares attacked by a knight standing on 'square'
+inline Bitboard knightAttacks(int square) {
+    return KnightAttacks[square];
+}
+
+// Returns the squares attacked by a king standing on 'square'
+inline Bitboard kingAttacks(int square) {
+    return KingAttacks[square];
+}
+
+// Returns the squares attacked by a bishop standing on 'square', stopping at the first occupied square in each direction
+inline Bitboard bishopAttacks(int square, Bitboard occupied) {
+    const Magic& m = BishopMagics[square];
+    return m.attacks[m.index(occupied)];
+}
+
+// Returns the squares attacked by a rook standing on 'square', stopping at the first occupied square in each direction
+inline Bitboard rookAttacks(int square, Bitboard occupied) {
+    const Magic& m = RookMagics[square];
+    return m.attacks[m.index(occupied)];
+}
+
+// Returns the squares attacked by a queen standing on 'square'
+inline Bitboard queenAttacks(int square, Bitboard occupied) {
+    return bishopAttacks(square, occupied) | rookAttacks(square, occupied);
+}
+
+// Returns the squares attacked by a knight, bishop, rook, queen or king standing on 'square'.
+// Pawns are not handled here, since their attacks depend on their color.
+inline Bitboard attacksOf(PieceType type, int square, Bitboard occupied) {
+    switch (type) {
+        case KNIGHT: return knightAttacks(square);
+        case BISHOP: return bishopAttacks(square, occupied);
+        case ROOK: return rookAttacks(square, occupied);
+        case QUEEN: return queenAttacks(square, occupied);
+        case KING: return kingAttacks(square);
+        default: return 0;
+    }
+}
+
+// Returns the squares strictly between two squares on the same rank, file or diagonal, or an empty bitboard otherwise
+inline Bitboard betweenBB(int from, int to) {
+    return BetweenBB[from][to];
+}
+
+// Returns the whole rank, file or diagonal through two squares, edge to edge, or an empty bitboard if they are not
+// on one. A piece pinned to its king may only move along the line through the king and itself.
+inline Bitboard lineBB(int from, int to) {
+    return LineBB[from][to];
+}
+
+#endif // ATTACKS_H
@@ -0,0 +1,281 @@
+// BenchMain.cpp
+// Command-line benchmark of the hot paths that do not search: loading positions from FEN and writing them back,
+// taking and restoring snapshots of them, creating a game per request, playing moves and evaluating positions.
+// Every operation is repeated many times, and its average time and number of heap allocations are printed.
+// The written FEN must match the loaded one, so the benchmark also checks that the two agree.
+// The handcrafted evaluation and the neural network are then run on the same positions and their speeds compared.
+// Without a network file, the network gets pseudo-random weights, which cost as much to run as trained ones.
+//
+// Usage:
+//   bench [iterations] [network file]
+//   bench check        checks that malformed and unplayable FEN strings are rejected with the right error
+
+#include "ChessGame.h"
+#include "Evaluator.h"
+#include "Nnue.h"
+#include "PawnTable.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+using std::cout;
+
+// Number of calls to the global operator new so far, counted to show which operations allocate
+static uint64_t allocations = 0;
+
+// Replacements of the global allocation functions that count the allocations
+void* operator new(size_t size) {
+	++allocations;
+	void* memory = std::malloc(size > 0 ? size : 1);
+	if (memory == nullptr) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+void operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+void operator delete(void* memory, size_t) noexcept {
+	std::free(memory);
+}
+
+// Positions with all six FEN fields, so that writing them back gives the same string
+static const char* const fens[] = {
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+	"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+	"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+	"rnbqkb1r/pp1p1ppp/5n2/2pPp3/8/8/PPP1PPPP/RNBQKBNR w KQkq e6 0 4",
+	"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+};
+
+// A FEN string together with the error parseFen must report for it
+struct FenCheck {
+	const char* name;
+	const char* fen;
+	FenError error;
+};
+
+static const FenCheck fenChecks[] = {
+	{"Start position", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", FEN_OK},
+	{"Three fields", "4k3/8/8/8/8/8/8/4K3 w -", FEN_OK},
+	{"Missing side", "4k3/8/8/8/8/8/8/4K3", FEN_MISSING_FIELD},
+	{"Seven ranks", "4k3/8/8/8/8/8/4K3 w - - 0 1", FEN_BAD_PLACEMENT},
+	{"Nine files", "4k3/9/8/8/8/8/8/4K3 w - - 0 1", FEN_BAD_PLACEMENT},
+	{"Unknown piece", "4k3/8/8/8/8/8/8/4K2X w - - 0 1", FEN_BAD_PLACEMENT},
+	{"No white king", "4k3/8/8/8/8/8/8/8 w - - 0 1", FEN_BAD_KINGS},
+	{"No black king", "8/8/8/8/8/8/8/4K3 w - - 0 1", FEN_BAD_KINGS},
+	{"Two white kings", "4k3/8/8/8/8/8/8/3KK3 w - - 0 1", FEN_BAD_KINGS},
+	{"Two black kings", "3kk3/8/8/8/8/8/8/4K3 b - - 0 1", FEN_BAD_KINGS},
+	{"White pawn on rank 8", "P3k3/8/8/8/8/8/8/4K3 w - - 0 1", FEN_BAD_PAWN},
+	{"Black pawn on rank 1", "4k3/8/8/8/8/8/8/p3K3 w - - 0 1", FEN_BAD_PAWN},
+	{"Bad side", "4k3/8/8/8/8/8/8/4K3 x - - 0 1", FEN_BAD_SIDE},
+	{"Black in check, Black to move", "4k3/4R3/8/8/8/8/8/4K3 b - - 0 1", FEN_OK},
+	{"Black in check, White to move", "4k3/4R3/8/8/8/8/8/4K3 w - - 0 1", FEN_OTHER_IN_CHECK},
+	{"White in check by a pawn, White to move", "4k3/8/8/8/8/8/3p4/4K3 w - - 0 1", FEN_OK},
+	{"White in check by a pawn, Black to move", "4k3/8/8/8/8/8/3p4/4K3 b - - 0 1", FEN_OTHER_IN_CHECK},
+	{"Adjacent kings", "8/8/8/3k4/3K4/8/8/8 w - - 0 1", FEN_OTHER_IN_CHECK},
+	{"Bad castling", "4k3/8/8/8/8/8/8/4K3 w X - 0 1", FEN_BAD_CASTLING},
+	{"Bad en passant", "4k3/8/8/8/8/8/8/4K3 w - e4 0 1", FEN_BAD_EN_PASSANT},
+	{"Bad halfmove clock", "4k3/8/8/8/8/8/8/4K3 w - - x 1", FEN_BAD_HALFMOVE},
+	{"Zero fullmove number", "4k3/8/8/8/8/8/8/4K3 w - - 0 0", FEN_BAD_FULLMOVE},
+	{"Trailing text", "4k3/8/8/8/8/8/8/4K3 w - - 0 1 x", FEN_TRAILING_TEXT},
+};
+
+// Parses every FEN string of fenChecks and compares the error. Returns the number of failures.
+static int runChecks() {
+	int failures = 0;
+	for (const FenCheck& check : fenChecks) {
+		FenPosition position;
+		FenResult result = parseFen(check.fen, position);
+		bool passed = (result.error == check.error);
+		cout << check.name << ": " << (passed ? "PASS" : "FAIL") << '\n';
+		failures += passed ? 0 : 1;
+	}
+	cout << (failures == 0 ? "All checks passed" : "Some checks failed") << '\n';
+	return failures;
+}
+
+// Prints the average time of one operation in nanoseconds and its average number of allocations,
+// given the time and the allocation count when the operations started
+static void report(const char* name, std::chrono::steady_clock::time_point start, uint64_t startAllocations,
+                   uint64_t operations) {
+	double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	cout << name << ": " << uint64_t(nanoseconds / operations) << " ns per call, "
+	     << double(allocations - startAllocations) / operations << " allocations per call\n";
+}
+
+// Evaluates every position one move away from each benchmark position with the evaluator, as a search does, and
+// returns the number of evaluations per second
+static double evaluationsPerSecond(Evaluator& evaluator, ChessGame& game, int iterations, int& evaluationSum) {
+	uint64_t evaluations = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i) {
+		for (const char* fen : fens) {
+			game.setState(fen);
+			MoveList moves;
+			game.generateLegalMoves(moves);
+			for (int m = 0; m < moves.size(); ++m) {
+				game.makeMove(moves[m]);
+				evaluationSum += evaluator.evaluate(game);
+				game.unmakeMove();
+			}
+			evaluations += moves.size();
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return seconds > 0 ? evaluations / seconds : 0;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc == 2 && std::string(argv[1]) == "check") {
+		return runChecks() == 0 ? 0 : 1;
+	}
+	int iterations = (argc >= 2) ? std::atoi(argv[1]) : 100000;
+	NnueNetwork network;
+	if (argc >= 3) {
+		if (!network.load(argv[2])) {
+			cout << "Cannot load network " << argv[2] << '\n';
+			return 1;
+		}
+	} else {
+		network.randomize(1);
+	}
+	ChessGame game;
+
+	// The written FEN must reproduce the loaded one
+	for (const char* fen : fens) {
+		FenResult result = game.setState(fen);
+		if (!result.ok() || game.toFEN() != fen) {
+			cout << "FEN round trip failed: " << fen << '\n';
+			return 1;
+		}
+	}
+
+	uint64_t operations = uint64_t(iterations) * (sizeof(fens) / sizeof(fens[0]));
+	uint64_t startAllocations = allocations;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i) {
+		for (const char* fen : fens) {
+			game.setState(fen);
+		}
+	}
+	report("setState", start, startAllocations, operations);
+
+	size_t totalLength = 0;
+	startAllocations = allocations;
+	start = std::chrono::steady_clock::now();
+	for (uint64_t i = 0; i < operations; ++i) {
+		totalLength += game.toFEN().size();
+	}
+	report("toFEN", start, startAllocations, operations);
+
+	FenPosition position;
+	startAllocations = allocations;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i) {
+		for (const char* fen : fens) {
+			totalLength += parseFen(fen, position).offset;
+		}
+	}
+	report("parseFen", start, startAllocations, operations);
+
+	// Taking and restoring snapshots is the cheap alternative to writing and loading FEN strings
+	BoardState states[sizeof(fens) / sizeof(fens[0])];
+	for (size_t i = 0; i < sizeof(fens) / sizeof(fens[0]); ++i) {
+		game.setState(fens[i]);
+		states[i] = game.snapshot();
+	}
+	startAllocations = allocations;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i) {
+		for (const BoardState& state : states) {
+			game.restore(state);
+			totalLength += game.snapshot().halfmoveClock;
+		}
+	}
+	report("snapshot+restore", start, startAllocations, operations);
+
+	// A server answering a request with a fresh game pays for creating and destroying it as well
+	startAllocations = allocations;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i) {
+		for (const char* fen : fens) {
+			ChessGame requestGame;
+			requestGame.setState(fen);
+			totalLength += requestGame.getGameStatus();
+		}
+	}
+	report("game per request", start, startAllocations, operations);
+
+	// Every legal move of each position is made and taken back, through the same path as the search
+	uint64_t moveCount = 0;
+	startAllocations = allocations;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations / 10; ++i) {
+		for (const char* fen : fens) {
+			game.setState(fen);
+			MoveList moves;
+			game.generateLegalMoves(moves);
+			for (int m = 0; m < moves.size(); ++m) {
+				game.makeMove(moves[m]);
+				game.unmakeMove();
+			}
+			moveCount += moves.size();
+		}
+	}
+	report("makeMove+unmakeMove", start, startAllocations, moveCount);
+
+	// The static evaluation runs at every leaf of a search; its material and piece-square terms are kept by the moves
+	int evaluationSum = 0;
+	startAllocations = allocations;
+	start = std::chrono::steady_clock::now();
+	for (const BoardState& state : states) {
+		game.restore(state);
+		for (int i = 0; i < iterations; ++i) {
+			evaluationSum += game.evaluate();
+		}
+	}
+	report("evaluate", start, startAllocations, operations);
+
+	// Evaluating every position one move away, as a search does, shows how often the pawn skeleton is already cached
+	PawnTable& pawnTable = PawnTable::forThread();
+	pawnTable.clear();
+	moveCount = 0;
+	startAllocations = allocations;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations / 10; ++i) {
+		for (const char* fen : fens) {
+			game.setState(fen);
+			MoveList moves;
+			game.generateLegalMoves(moves);
+			for (int m = 0; m < moves.size(); ++m) {
+				game.makeMove(moves[m]);
+				evaluationSum += game.evaluate();
+				game.unmakeMove();
+			}
+			moveCount += moves.size();
+		}
+	}
+	report("makeMove+evaluate+unmakeMove", start, startAllocations, moveCount);
+	uint64_t probes = pawnTable.getHits() + pawnTable.getMisses();
+	cout << "pawn table: " << pawnTable.getHits() << " hits, " << pawnTable.getMisses() << " misses ("
+	     << (probes > 0 ? 100.0 * pawnTable.getHits() / probes : 0.0) << "% hits)\n";
+
+	// The network's accumulator of each position is updated from the one of the benchmark position it comes from
+	HandcraftedEvaluator handcrafted;
+	NnueEvaluator nnue(network);
+	for (Evaluator* evaluator : {static_cast<Evaluator*>(&handcrafted), static_cast<Evaluator*>(&nnue)}) {
+		startAllocations = allocations;
+		double rate = evaluationsPerSecond(*evaluator, game, iterations / 10, evaluationSum);
+		cout << evaluator->getName() << " evaluator: " << uint64_t(rate) << " evaluations per second, "
+		     << allocations - startAllocations << " allocations\n";
+	}
+	cout << "nnue accumulators: " << nnue.getUpdates() << " updated, " << nnue.getRefreshes() << " refreshed\n";
+	totalLength += size_t(evaluationSum & 1);
+
+	return totalLength > 0 ? 0 : 1;
+}
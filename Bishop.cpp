@@ -34,4 +34,4 @@ bool Bishop::isValidMove(const Position& from, const Position& to, const ChessGa
 
     // A valid bishop move must have equal row and column differences (move diagonally)
     return (rowDifference == colDifference);
-}
\ No newline at end of file
+}
@@ -0,0 +1,97 @@
+// Bitboard.h
+// This file defines the Bitboard type and the helpers used to translate between board squares and bits.
+// A bitboard is a 64-bit integer where each bit represents one square of the chessboard.
+// Squares are numbered from 0 (A1) to 63 (H8), rank by rank, so bit 'square' is set when that square is occupied.
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "Position.h"
+#include "Color.h"
+#include <cstdint>
+
+// A set of squares, one bit per square
+typedef uint64_t Bitboard;
+
+// Defining PieceType enumeration, used to index the piece bitboards of each color
+enum PieceType {
+    PAWN,
+    KNIGHT,
+    BISHOP,
+    ROOK,
+    QUEEN,
+    KING,
+    PIECE_TYPE_NB // Number of piece types
+};
+
+// Defining CastlingRight enumeration, one bit per castling right so that the four rights fit in a 4-bit mask
+enum CastlingRight {
+    NO_CASTLING = 0,
+    WHITE_KING_SIDE = 1,
+    WHITE_QUEEN_SIDE = 2,
+    BLACK_KING_SIDE = 4,
+    BLACK_QUEEN_SIDE = 8,
+    ALL_CASTLING = 15,
+    CASTLING_RIGHT_NB = 16 // Number of distinct masks
+};
+
+// Number of squares on the board
+const int SQUARE_NB = 64;
+
+// Bitboards of the files and ranks used by the move rules
+const Bitboard FILE_A_BB = 0x0101010101010101ULL;
+const Bitboard FILE_H_BB = FILE_A_BB << 7;
+const Bitboard RANK_1_BB = 0xFFULL;
+const Bitboard RANK_8_BB = RANK_1_BB << 56;
+
+// Bitboard of the dark squares (A1 is dark), used to tell the color of a bishop's squares
+const Bitboard DARK_SQUARES_BB = 0xAA55AA55AA55AA55ULL;
+
+// Converts a Position (row 0 is the 8th rank) to a square index (0 is A1)
+inline int squareOf(const Position& pos) {
+    return (7 - pos.getRow()) * 8 + pos.getCol();
+}
+
+// Converts a square index back to a Position
+inline Position positionOf(int square) {
+    return Position(7 - square / 8, square % 8);
+}
+
+// Returns the rank (0 - 7, 0 being the 1st rank) of a square
+inline int rankOf(int square) {
+    return square >> 3;
+}
+
+// Returns the file (0 - 7, 0 being file 'A') of a square
+inline int fileOf(int square) {
+    return square & 7;
+}
+
+// Returns a bitboard with only the given square set
+inline Bitboard squareBB(int square) {
+    return 1ULL << square;
+}
+
+// Returns the number of squares set in the bitboard
+inline int popCount(Bitboard b) {
+    return __builtin_popcountll(b);
+}
+
+// Returns the lowest square set in a non-empty bitboard
+inline int lsb(Bitboard b) {
+    return __builtin_ctzll(b);
+}
+
+// Returns the lowest square set in a non-empty bitboard and clears it
+inline int popLsb(Bitboard& b) {
+    int square = lsb(b);
+    b &= b - 1;
+    return square;
+}
+
+// Returns the index (0 - 11) of the bitboard holding pieces of the given color and type
+inline int pieceIndex(Color color, PieceType type) {
+    return color * PIECE_TYPE_NB + type;
+}
+
+#endif // BITBOARD_H
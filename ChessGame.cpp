@@ -7,510 +7,1209 @@
 #include "Bishop.h"
 #include "Queen.h"
 #include "King.h"
-#include <iostream>
-#include <sstream>
+#include "Attacks.h"
+#include "Zobrist.h"
+#include "TranspositionTable.h"
+#include "GameObserver.h"
+#include "Evaluation.h"
+#include <cctype>
 using namespace std;
 
 // Constructor that initializes an empty chessboard
 ChessGame::ChessGame() {
-    // Initialize all positions to nullptr directly
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            board[row][col] = nullptr;
-        }
+    // Make sure the attack lookup tables and the hash keys are ready before any position is set up
+    initAttacks();
+    initZobrist();
+    initEvaluation();
+
+    // Initialize all squares to empty
+    for (int square = 0; square < SQUARE_NB; ++square) {
+        board[square] = NO_PIECE;
     }
+    // Initialize all bitboards to empty
+    for (int i = 0; i < 2 * PIECE_TYPE_NB; ++i) {
+        state.pieces[i] = 0;
+    }
+    state.occupancy[WHITE] = state.occupancy[BLACK] = 0;
+    state.pieceSquareScore = 0;
+    state.phase = 0;
+
+    state.currentTurn = WHITE; // Set the initial turn to WHITE
+    state.castlingRights = ALL_CASTLING; // Allow castling for both players initially
+    state.enPassantSquare = NO_SQUARE;
+    state.halfmoveClock = 0;
+    state.fullmoveNumber = 1;
+    state.positionKey = computeKey();
+    state.pawnKey = computePawnKey();
+    transpositionTable = nullptr;
+    observer = nullptr;
+}
 
-    currentTurn = WHITE; // Set the initial turn to WHITE
-    whiteKingSideCastling = whiteQueenSideCastling = true; // Allow castling for white initially
-    blackKingSideCastling = blackQueenSideCastling = true; // Allow castling for black initially
+// CastlingMaskTable holds, for each square, the castling rights that survive a move starting or ending on it.
+// A move from or to a king's original square clears both rights of that king, and a move from or to a rook's corner
+// clears the right of that rook, so 'rights &= kept[from] & kept[to]' updates the mask for every move.
+struct CastlingMaskTable {
+    uint8_t kept[SQUARE_NB];
+};
+
+// Helper function to build the castling mask table at compile time
+static constexpr CastlingMaskTable makeCastlingMasks() {
+    CastlingMaskTable table = {};
+    for (int square = 0; square < SQUARE_NB; ++square) {
+        table.kept[square] = ALL_CASTLING;
+    }
+    table.kept[4] = ALL_CASTLING & ~(WHITE_KING_SIDE | WHITE_QUEEN_SIDE);
+    table.kept[7] = ALL_CASTLING & ~WHITE_KING_SIDE;
+    table.kept[0] = ALL_CASTLING & ~WHITE_QUEEN_SIDE;
+    table.kept[60] = ALL_CASTLING & ~(BLACK_KING_SIDE | BLACK_QUEEN_SIDE);
+    table.kept[63] = ALL_CASTLING & ~BLACK_KING_SIDE;
+    table.kept[56] = ALL_CASTLING & ~BLACK_QUEEN_SIDE;
+    return table;
 }
 
-// Destructor that ensures proper cleanup of all chess pieces
-ChessGame::~ChessGame() {
-    // Delete all pieces from the board by the helper function
-    clearBoard();
+static constexpr CastlingMaskTable CastlingMasks = makeCastlingMasks();
+
+// Helper function returning the castling right of one player on one side
+static CastlingRight castlingRightOf(Color color, bool isKingSide) {
+    if (color == WHITE) {
+        return isKingSide ? WHITE_KING_SIDE : WHITE_QUEEN_SIDE;
+    }
+    return isKingSide ? BLACK_KING_SIDE : BLACK_QUEEN_SIDE;
 }
 
-// Method to initialize the board with a given FEN string
+// Helper function returning the shared ChessPiece object standing for a piece code.
+// The objects hold nothing but their color, so one of each color and type serves every game.
+static const ChessPiece* pieceObject(Piece piece) {
+    static const Pawn whitePawn(WHITE), blackPawn(BLACK);
+    static const Knight whiteKnight(WHITE), blackKnight(BLACK);
+    static const Bishop whiteBishop(WHITE), blackBishop(BLACK);
+    static const Rook whiteRook(WHITE), blackRook(BLACK);
+    static const Queen whiteQueen(WHITE), blackQueen(BLACK);
+    static const King whiteKing(WHITE), blackKing(BLACK);
+    static const ChessPiece* const objects[NO_PIECE + 1] = {
+        &whitePawn, &whiteKnight, &whiteBishop, &whiteRook, &whiteQueen, &whiteKing,
+        &blackPawn, &blackKnight, &blackBishop, &blackRook, &blackQueen, &blackKing,
+        nullptr
+    };
+    return objects[piece];
+}
+
+// Method to initialize the board with a given FEN string and report the result to the observer
 void ChessGame::loadState(const string& fen) {
-    // Clear the board first
+    FenResult result = setState(fen);
+    if (observer != nullptr) {
+        observer->onStateLoaded(result);
+    }
+}
+
+// Method to initialize the board with a given FEN string without any output.
+// The string is parsed completely before the board is touched, so an invalid one leaves the game as it was.
+FenResult ChessGame::setState(string_view fen) {
+    FenPosition position;
+    FenResult result = parseFen(fen, position);
+    if (!result.ok()) {
+        return result;
+    }
+
     clearBoard();
-    
-    // Import the FEN string 
-    istringstream fenStream(fen); // Create a string stream to parse the FEN string
-    string piecePlacement, activeColor, castlingAvailability; // Define the string variables for piece placement, active color, and castling availability respectively
-    fenStream >> piecePlacement >> activeColor >> castlingAvailability; // Extract from the FEN string
-    if (piecePlacement.empty() || activeColor.empty() || castlingAvailability.empty()) { //Chekc if the format of the FEN string is valid
-        cout << "Invalid FEN string format." << endl;
-        return;
-    }
-
-    // Initialize the board with the given FEN
-    int row = 0;
-    int col = 0;
-    for (char c : piecePlacement) { // Iterate through each character in the FEN piece placement string 
-        if (c == '/') {
-            row++; // Move to the next row
-            col = 0; // Reset column to the start
-        } else if (isdigit(c)) {
-            col += c - '0'; // Skip the number of empty squares indicated by the digit
-        } else {
-            Color color = isupper(c) ? WHITE : BLACK; // Determine the color of the piece based on whether the character is uppercase or lowercase
-            c = tolower(c); // Convert to lowercase for the switch() function later
-            ChessPiece* piece = nullptr; //Create a pointer to ChessPiece and point to null
-
-            switch (c) { // Create the appropriate piece based on the character
-                case 'p': piece = new Pawn(color); break;
-                case 'r': piece = new Rook(color); break;
-                case 'n': piece = new Knight(color); break;
-                case 'b': piece = new Bishop(color); break;
-                case 'q': piece = new Queen(color); break;
-                case 'k': piece = new King(color); break;
+    for (int square = 0; square < SQUARE_NB; ++square) {
+        int piece = position.board[square];
+        if (piece >= 0) {
+            putPiece(Piece(piece), square);
+        }
+    }
+    state.currentTurn = position.sideToMove;
+    // A right whose king or rook is not on its original square can never be used, so it is dropped. Two FEN strings
+    // that only differ by such a right then give the same state and the same hash.
+    state.castlingRights = uint8_t(position.castlingRights);
+    for (Color color : {WHITE, BLACK}) {
+        for (bool isKingSide : {true, false}) {
+            int kingSquare = (color == WHITE) ? 4 : 60;
+            int rookSquare = kingSquare + (isKingSide ? 3 : -4);
+            if (board[kingSquare] != makePiece(color, KING) || board[rookSquare] != makePiece(color, ROOK)) {
+                state.castlingRights &= ~castlingRightOf(color, isKingSide);
             }
+        }
+    }
+    // Likewise, an en passant square is only kept when a pawn of the player to move could capture on it, as
+    // makeMove does, so that a position reached by a two-square move and the same position loaded from FEN agree
+    Color lastMover = (state.currentTurn == WHITE) ? BLACK : WHITE;
+    state.enPassantSquare = NO_SQUARE;
+    if (position.enPassantSquare != NO_SQUARE
+        && (pawnAttacks(lastMover, position.enPassantSquare) & state.pieces[pieceIndex(state.currentTurn, PAWN)])) {
+        state.enPassantSquare = position.enPassantSquare;
+    }
+    state.halfmoveClock = position.halfmoveClock;
+    state.fullmoveNumber = position.fullmoveNumber;
 
-            board[row][col] = piece; // Place the piece on the board
-            col++; // Move to the next column
+    // Hash the new position from scratch; moves keep it up to date from here on
+    state.positionKey = computeKey();
+    state.pawnKey = computePawnKey();
+    return result;
+}
+
+// Method to write the position as a FEN string with all six fields
+string ChessGame::toFEN() const {
+    static const char symbols[] = "PNBRQKpnbrqk";
+    char buffer[128];
+    int length = 0;
+
+    for (int rank = 7; rank >= 0; --rank) {
+        int empty = 0;
+        for (int file = 0; file < 8; ++file) {
+            int square = rank * 8 + file;
+            PieceType type = pieceTypeOn(square);
+            if (type == PIECE_TYPE_NB) {
+                ++empty;
+                continue;
+            }
+            if (empty > 0) {
+                buffer[length++] = char('0' + empty);
+                empty = 0;
+            }
+            Color color = (state.occupancy[WHITE] & squareBB(square)) ? WHITE : BLACK;
+            buffer[length++] = symbols[pieceIndex(color, type)];
+        }
+        if (empty > 0) {
+            buffer[length++] = char('0' + empty);
         }
+        buffer[length++] = (rank > 0) ? '/' : ' ';
     }
 
-    // Set the current turn based on the FEN string with error check
-    if (activeColor == "w") {
-        currentTurn = WHITE;
-    } else if (activeColor == "b") {
-        currentTurn = BLACK;
+    buffer[length++] = (state.currentTurn == WHITE) ? 'w' : 'b';
+    buffer[length++] = ' ';
+
+    int castlingStart = length;
+    if (state.castlingRights & WHITE_KING_SIDE) buffer[length++] = 'K';
+    if (state.castlingRights & WHITE_QUEEN_SIDE) buffer[length++] = 'Q';
+    if (state.castlingRights & BLACK_KING_SIDE) buffer[length++] = 'k';
+    if (state.castlingRights & BLACK_QUEEN_SIDE) buffer[length++] = 'q';
+    if (length == castlingStart) buffer[length++] = '-';
+    buffer[length++] = ' ';
+
+    if (state.enPassantSquare == NO_SQUARE) {
+        buffer[length++] = '-';
     } else {
-        cout << "Invalid active color in FEN string." << endl;
-        return;
+        buffer[length++] = char('a' + fileOf(state.enPassantSquare));
+        buffer[length++] = char('1' + rankOf(state.enPassantSquare));
     }
 
-    // Set castling availability based on the FEN string
-    whiteKingSideCastling = (castlingAvailability.find('K') != std::string::npos); // Check if white can castle kingside
-    whiteQueenSideCastling = (castlingAvailability.find('Q') != std::string::npos); // Check if white can castle queenside
-    blackKingSideCastling = (castlingAvailability.find('k') != std::string::npos); // Check if black can castle kingside
-    blackQueenSideCastling = (castlingAvailability.find('q') != std::string::npos); // Check if black can castle queenside
-
-    cout << "A new board state is loaded!" << endl;
+    // The two counters, each written digit by digit
+    for (int number : {state.halfmoveClock, state.fullmoveNumber}) {
+        char digits[12];
+        int count = 0;
+        do {
+            digits[count++] = char('0' + number % 10);
+            number /= 10;
+        } while (number > 0);
+        buffer[length++] = ' ';
+        while (count > 0) {
+            buffer[length++] = digits[--count];
+        }
+    }
+    return string(buffer, length);
 }
 
 
 // Method to submit a move
-bool ChessGame::submitMove(const string& fromStr, const string& toStr) {
+bool ChessGame::submitMove(const string& fromStr, const string& toStr, PieceType promotion) {
     Position from = Position(fromStr); //Convert the input string to a Position
     Position to = Position(toStr); //Convert the input string to a Position
-    return Move(from, to);
+    return playMove(from, to, promotion).ok();
 }
 
-// Method to check the validity of a move
+// Method to execute a move, reporting only whether it was played
 bool ChessGame::Move(const Position& from, const Position& to) {
-    // Get the piece at the source position
-    ChessPiece* piece = getPieceAt(from);
-    
+    return playMove(from, to).ok();
+}
+
+// Method to check the validity of a move and play it.
+// The result is handed to the observer before it is returned, whether the move was played or not.
+MoveResult ChessGame::playMove(const Position& from, const Position& to, PieceType promotion) {
+    MoveResult result;
+    result.from = from;
+    result.to = to;
+
     // General check for the move (e.g., turn color, valid position, from-to cannot be the same)
-    if (!initialCheck(from, to)){
-        return false;
+    result.outcome = initialOutcome(from, to);
+    if (result.outcome != MOVE_NO_PIECE) {
+        result.color = colorOf(pieceOn(squareOf(from)));
+        result.piece = pieceTypeOn(squareOf(from));
+    }
+    if (result.outcome == MOVE_OK) {
+        result.outcome = moveOutcome(from, to, promotion, result);
+    }
+    if (result.outcome == MOVE_OK) {
+        // Check if the opponent's king is in check, checkmate or stalemate after the move
+        result.status = getGameStatus();
     }
 
+    if (observer != nullptr) {
+        observer->onMove(result);
+    }
+    return result;
+}
+
+// Helper function to apply the moving rules to a move that passed the initial checks, and play it if it is legal
+MoveOutcome ChessGame::moveOutcome(const Position& from, const Position& to, PieceType promotion, MoveResult& result) {
+    int fromSquare = squareOf(from);
+    int toSquare = squareOf(to);
+    PieceType pieceType = result.piece;
+
     // Check if this is a castling move
-    if (piece->getSymbol() == 'K' && abs(to.getCol() - from.getCol()) == 2) {
-        // Call performCastling to handle castling logic
-        if (performCastling(from, to)) {
-            // Update the turn
-            currentTurn = (currentTurn == WHITE) ? BLACK : WHITE;
-            return true;
+    if (pieceType == KING && abs(to.getCol() - from.getCol()) == 2) {
+        // Call performCastling to handle castling logic, which also passes the turn
+        result.castling = true;
+        return performCastling(from, to);
+    }
+
+    // If not a castling move, then proceed with regular move logic.
+    // The moving rule of each piece, including a clear path for sliding pieces and never landing on a piece of
+    // the same color, comes from the attack tables.
+    if (!(targetsFrom(fromSquare) & squareBB(toSquare))) {
+        return MOVE_ILLEGAL;
+    }
+
+    // A pawn taking on the en passant square captures en passant, and a pawn reaching the last rank promotes
+    ChessMove move(fromSquare, toSquare);
+    if (pieceType == PAWN && toSquare == state.enPassantSquare) {
+        move = ChessMove(fromSquare, toSquare, EN_PASSANT);
+    } else if (pieceType == PAWN && (squareBB(toSquare) & (RANK_1_BB | RANK_8_BB))) {
+        if (promotion < KNIGHT || promotion > QUEEN) {
+            return MOVE_ILLEGAL;
         }
-        cout << "Not valid castling" << endl;
-        return false;
+        move = ChessMove(fromSquare, toSquare, PROMOTION, promotion);
+        result.promotion = promotion;
     }
 
-    // If not a castling move, then proceed with regular move logic
-    // Check if the move of the piece is valid by the moving rule of each piece 
-    if (!piece->isValidMove(from, to, *this)) { 
-        printInvalidMoveMessage(piece, to); // Call helpter function to output message of invlid move
-        return false;
+    // Check if the move would leave the current player's king in check, without trying it on the board
+    if (!isLegal(move, legalityInfo(state.currentTurn))) {
+        return MOVE_OWN_KING_IN_CHECK;
+    }
+
+    // Make the piece move, which also passes the turn to the opponent
+    makeMove(move);
+    result.captured = history.top().capturedType;
+    return MOVE_OK;
+}
+
+
+// General check for the move (e.g., turn color, valid position, from-to cannot be the same)
+bool ChessGame::initialCheck(const Position& from, const Position& to) const{
+    return initialOutcome(from, to) == MOVE_OK;
+}
+
+// Helper function for the general checks of a move, telling which one failed
+MoveOutcome ChessGame::initialOutcome(const Position& from, const Position& to) const {
+    // Get the piece at the source position
+    Piece piece = from.isValid() ? pieceOn(squareOf(from)) : NO_PIECE;
+  
+    // Check if there is no piece at the source position
+    if (piece == NO_PIECE) {
+        return MOVE_NO_PIECE;
+    }
+
+    // Check if the moving piece belongs to the cuurent player
+    if (colorOf(piece) != state.currentTurn) {
+        return MOVE_WRONG_TURN;
+    }
+
+    // Check if both positions are valid, and not the same
+    if (!from.isValid() || !to.isValid() || from == to) {
+        return MOVE_ILLEGAL;
+    }
+    return MOVE_OK;
+}
+
+// Method to check if the path between 'from' and 'to' is clear (i.e., no pieces in the way)
+bool ChessGame::isPathClear(const Position& from, const Position& to) const {
+    // The squares strictly between 'from' and 'to' come from a precomputed table,
+    // so the path is clear when none of them is occupied
+    Bitboard path = betweenBB(squareOf(from), squareOf(to));
+    return (path & (state.occupancy[WHITE] | state.occupancy[BLACK])) == 0;
+}
+
+// Method to check if a king is in check
+bool ChessGame::isKingInCheck(Color kingColor) const {
+    // Find the king's position from its bitboard
+    Bitboard king = state.pieces[pieceIndex(kingColor, KING)];
+    if (king == 0) {
+        return false; // Without a king on the board there is nothing to attack
     }
 
-    // Additional check for the pieces that require the path between 'from' and 'to' is clear (Bishop, Rook, Queen))
-    char pieceSymbol = piece->getSymbol();
-    if (pieceSymbol == 'R' || pieceSymbol == 'B' || pieceSymbol == 'Q') {
-        if (!isPathClear(from, to)) {
-            printInvalidMoveMessage(piece, to);
-            return false;
+    // Check if any opposing piece can attack the king's position
+    return isSquareAttacked(lsb(king), (kingColor == WHITE) ? BLACK : WHITE);
+}
+
+// Method to check if a square is attacked by any piece of the given color
+bool ChessGame::isSquareAttacked(int square, Color attackerColor) const {
+    Bitboard occupied = state.occupancy[WHITE] | state.occupancy[BLACK];
+    Color defenderColor = (attackerColor == WHITE) ? BLACK : WHITE;
+
+    // A pawn attacks the square if it stands where a defending pawn on the square would capture
+    if (pawnAttacks(defenderColor, square) & state.pieces[pieceIndex(attackerColor, PAWN)]) {
+        return true;
+    }
+    if (knightAttacks(square) & state.pieces[pieceIndex(attackerColor, KNIGHT)]) {
+        return true;
+    }
+    if (kingAttacks(square) & state.pieces[pieceIndex(attackerColor, KING)]) {
+        return true;
+    }
+
+    // Sliding pieces attack the square if it sees them along an unblocked ray
+    Bitboard queens = state.pieces[pieceIndex(attackerColor, QUEEN)];
+    if (bishopAttacks(square, occupied) & (state.pieces[pieceIndex(attackerColor, BISHOP)] | queens)) {
+        return true;
+    }
+    return (rookAttacks(square, occupied) & (state.pieces[pieceIndex(attackerColor, ROOK)] | queens)) != 0;
+}
+
+
+// Method to check if the king is in checkmate
+bool ChessGame::isCheckmate(Color kingColor) const {
+    // Checkmate is a check that no legal move can escape
+    LegalityInfo info = legalityInfo(kingColor);
+    return info.checkers != 0 && !hasLegalMove(kingColor, info);
+}
+
+// Method to check if there is a stalemate
+bool ChessGame::isStalemate(Color color) const {
+    // Stalemate is having no legal move while not being in check
+    LegalityInfo info = legalityInfo(color);
+    return info.checkers == 0 && !hasLegalMove(color, info);
+}
+
+// Method to generate every legal move of the player whose turn it is
+void ChessGame::generateLegalMoves(MoveList& moves) const {
+    MoveList pseudoLegalMoves;
+    generatePseudoLegalMoves(state.currentTurn, pseudoLegalMoves, false);
+
+    // Keep only the moves that do not leave the player's own king in check
+    LegalityInfo info = legalityInfo(state.currentTurn);
+    moves.clear();
+    for (const ChessMove& move : pseudoLegalMoves) {
+        if (isLegal(move, info)) {
+            moves.add(move);
         }
     }
+}
 
-    // Check if the destination position is occupied by the current player's piece
-    ChessPiece* targetPiece = board[to.getRow()][to.getCol()];
-    if (targetPiece != nullptr && targetPiece->getColor() == piece->getColor()) {
-        printInvalidMoveMessage(piece, to);
-        return false;
+// Method to generate the legal captures of the player whose turn it is
+void ChessGame::generateLegalCaptures(MoveList& moves) const {
+    MoveList pseudoLegalMoves;
+    generatePseudoLegalMoves(state.currentTurn, pseudoLegalMoves, true);
+
+    LegalityInfo info = legalityInfo(state.currentTurn);
+    moves.clear();
+    for (const ChessMove& move : pseudoLegalMoves) {
+        if (isLegal(move, info)) {
+            moves.add(move);
+        }
+    }
+}
+
+// Method to count the leaf nodes of the legal move tree of the given depth
+uint64_t ChessGame::perft(int depth, vector<pair<ChessMove, uint64_t>>* rootCounts) {
+    MoveList moves;
+    generateLegalMoves(moves);
+    if (depth <= 1 && rootCounts == nullptr) {
+        return (depth == 1) ? moves.size() : 1; // Leaf moves are counted without being played
+    }
+
+    uint64_t nodes = 0;
+    for (const ChessMove& move : moves) {
+        makeMove(move);
+        uint64_t count = (depth > 1) ? perft(depth - 1) : 1;
+        unmakeMove();
+
+        nodes += count;
+        if (rootCounts != nullptr) {
+            rootCounts->emplace_back(move, count);
+        }
+    }
+    return nodes;
+}
+
+// Method to play a legal move without validation, recording what is needed to take it back
+void ChessGame::makeMove(const ChessMove& move) {
+    int from = move.getFrom();
+    int to = move.getTo();
+    Color opponentColor = (state.currentTurn == WHITE) ? BLACK : WHITE;
+    PieceType type = pieceTypeOn(from);
+
+    // Save the state that the move is about to overwrite
+    UndoInfo undo;
+    undo.move = move;
+    undo.movedType = type;
+    undo.castlingRights = state.castlingRights;
+    undo.enPassantSquare = state.enPassantSquare;
+    undo.halfmoveClock = state.halfmoveClock;
+    undo.key = state.positionKey;
+    undo.pawnKey = state.pawnKey;
+
+    // Move the piece, recording the type of the captured piece for unmakeMove.
+    // The pawn key only changes when a pawn moves or is captured.
+    relocatePiece(from, to, undo.capturedType);
+    state.positionKey ^= ZobristPieces[pieceIndex(state.currentTurn, type)][from] ^ ZobristPieces[pieceIndex(state.currentTurn, type)][to];
+    if (type == PAWN) {
+        state.pawnKey ^= ZobristPieces[pieceIndex(state.currentTurn, PAWN)][from] ^ ZobristPieces[pieceIndex(state.currentTurn, PAWN)][to];
+    }
+    if (undo.capturedType != PIECE_TYPE_NB) {
+        state.positionKey ^= ZobristPieces[pieceIndex(opponentColor, undo.capturedType)][to];
+        if (undo.capturedType == PAWN) {
+            state.pawnKey ^= ZobristPieces[pieceIndex(opponentColor, PAWN)][to];
+        }
+    }
+    if (move.getType() == EN_PASSANT) {
+        // The captured pawn stands behind the destination square, on the rank the moving pawn left
+        int capturedSquare = (state.currentTurn == WHITE) ? to - 8 : to + 8;
+        removePiece(capturedSquare);
+        state.positionKey ^= ZobristPieces[pieceIndex(opponentColor, PAWN)][capturedSquare];
+        state.pawnKey ^= ZobristPieces[pieceIndex(opponentColor, PAWN)][capturedSquare];
+        undo.capturedType = PAWN;
+    } else if (move.getType() == PROMOTION) {
+        // The pawn that reached the last rank is replaced by the chosen piece
+        removePiece(to);
+        putPiece(makePiece(state.currentTurn, move.getPromotion()), to);
+        state.positionKey ^= ZobristPieces[pieceIndex(state.currentTurn, PAWN)][to]
+                           ^ ZobristPieces[pieceIndex(state.currentTurn, move.getPromotion())][to];
+        state.pawnKey ^= ZobristPieces[pieceIndex(state.currentTurn, PAWN)][to];
+    } else if (move.getType() == CASTLING) {
+        // The rook jumps to the square the king passed over
+        int rookFrom = (to > from) ? from + 3 : from - 4;
+        int rookTo = (to > from) ? from + 1 : from - 1;
+        PieceType rookCapturedType;
+        relocatePiece(rookFrom, rookTo, rookCapturedType);
+        state.positionKey ^= ZobristPieces[pieceIndex(state.currentTurn, ROOK)][rookFrom] ^ ZobristPieces[pieceIndex(state.currentTurn, ROOK)][rookTo];
+    }
+    // A king leaving its original square gives up both castling rights, and a rook leaving or being captured on its
+    // corner gives up that side's. The hash only changes when the rights do, which few moves cause.
+    uint8_t castlingRights = state.castlingRights & CastlingMasks.kept[from] & CastlingMasks.kept[to];
+    if (castlingRights != state.castlingRights) {
+        state.positionKey ^= ZobristCastling[state.castlingRights] ^ ZobristCastling[castlingRights];
+        state.castlingRights = castlingRights;
+    }
+
+    // A two-square pawn move leaves the skipped square as the en passant square, but only when an opponent's pawn
+    // could capture on it, so that positions differing by an unusable en passant square hash alike for repetitions
+    if (state.enPassantSquare != NO_SQUARE) {
+        state.positionKey ^= ZobristEnPassant[fileOf(state.enPassantSquare)];
+    }
+    state.enPassantSquare = NO_SQUARE;
+    if (type == PAWN && abs(to - from) == 16
+        && (pawnAttacks(state.currentTurn, (from + to) / 2) & state.pieces[pieceIndex(opponentColor, PAWN)])) {
+        state.enPassantSquare = (from + to) / 2;
+    }
+    if (state.enPassantSquare != NO_SQUARE) {
+        state.positionKey ^= ZobristEnPassant[fileOf(state.enPassantSquare)];
+    }
+
+    // Pawn moves and captures reset the halfmove clock, and the full move number grows after Black's move
+    state.halfmoveClock = (type == PAWN || undo.capturedType != PIECE_TYPE_NB) ? 0 : state.halfmoveClock + 1;
+    if (state.currentTurn == BLACK) {
+        state.fullmoveNumber++;
     }
 
-    // Make the piece move
-    ChessPiece* capturedPiece = board[to.getRow()][to.getCol()];
-    board[to.getRow()][to.getCol()] = piece;
-    board[from.getRow()][from.getCol()] = nullptr;
+    state.currentTurn = opponentColor;
+    state.positionKey ^= ZobristSide;
+    history.push(undo);
+}
 
-    // Check if the move puts the current player's king in check 
-    if (isKingInCheck(piece->getColor())) {
-        // If yes, Undo the move
-        board[from.getRow()][from.getCol()] = piece;
-        board[to.getRow()][to.getCol()] = capturedPiece;
-        cout << "Move puts your own king in check." << endl;
-        return false; // Return false if the move is illegal
+// Method to take back the last move, restoring the state saved in its undo record
+void ChessGame::unmakeMove() {
+    if (history.empty()) {
+        return; // Nothing to take back
     }
+    const UndoInfo& undo = history.top();
+    int from = undo.move.getFrom();
+    int to = undo.move.getTo();
 
-    // If the move does not lead to a check, then finalize the move
-    // Generate the move message before actually moving the piece
-    string color = (piece->getColor() == WHITE ? "White's " : "Black's ");
-    if (capturedPiece != nullptr) {
-        cout << color << piece->getName() << " moves from " << from << " to " << to << " taking " << (piece->getColor() == WHITE ? "Black's " : "White's ") << capturedPiece->getName() << endl;;
-    }else{
-        cout << color << piece->getName() << " moves from " << from << " to " << to << endl;
+    state.currentTurn = (state.currentTurn == WHITE) ? BLACK : WHITE;
+    if (state.currentTurn == BLACK) {
+        state.fullmoveNumber--;
     }
 
-    // Delete captured piece
-    if (capturedPiece != nullptr) {
-        delete capturedPiece;
+    Color opponentColor = (state.currentTurn == WHITE) ? BLACK : WHITE;
+    if (undo.move.getType() == CASTLING) {
+        revertRelocation((to > from) ? from + 3 : from - 4, (to > from) ? from + 1 : from - 1, PIECE_TYPE_NB);
+    } else if (undo.move.getType() == PROMOTION) {
+        removePiece(to);
+        putPiece(makePiece(state.currentTurn, PAWN), to);
+    }
+    if (undo.move.getType() == EN_PASSANT) {
+        revertRelocation(from, to, PIECE_TYPE_NB);
+        putPiece(makePiece(opponentColor, PAWN), (state.currentTurn == WHITE) ? to - 8 : to + 8);
+    } else {
+        revertRelocation(from, to, undo.capturedType);
     }
 
-    // Check if the opponent's king is in check or checkmate after the move
-    Color opponentColor = (currentTurn == WHITE) ? BLACK : WHITE;
-    if (isKingInCheck(opponentColor)) {       
-        if (isCheckmate(opponentColor)) {
-            cout << (opponentColor == WHITE ? "White" : "Black") << " is in checkmate" << endl;
-            return true; // Game over
+    state.castlingRights = undo.castlingRights;
+    state.enPassantSquare = undo.enPassantSquare;
+    state.halfmoveClock = undo.halfmoveClock;
+    state.positionKey = undo.key;
+    state.pawnKey = undo.pawnKey;
+    history.pop();
+}
+
+// Getter for the Zobrist hash of the position
+uint64_t ChessGame::hash() const {
+    return state.positionKey;
+}
+
+// Method to take a copy of the current position
+BoardState ChessGame::snapshot() const {
+    return state;
+}
+
+// Method to set the position to a snapshot.
+// The piece codes of the board are rebuilt from the bitboards, and the undo records of the moves that led to the
+// position the game had before are dropped, since they do not lead to the restored one.
+void ChessGame::restore(const BoardState& boardState) {
+    state = boardState;
+    for (int square = 0; square < SQUARE_NB; ++square) {
+        board[square] = NO_PIECE;
+    }
+    for (int piece = W_PAWN; piece < NO_PIECE; ++piece) {
+        Bitboard squares = state.pieces[piece];
+        while (squares) {
+            board[popLsb(squares)] = Piece(piece);
         }
-        cout << (opponentColor == WHITE ? "White" : "Black") << " is in check" << endl;
-    } else if (isStalemate(opponentColor)) {
-        cout << (opponentColor == WHITE ? "White" : "Black") << " is in stalemate" << endl;
-        return true; // Game over
     }
+    history.clear();
+    earlierKeys.clear();
+}
 
-    // Update the current turn
-    currentTurn = (currentTurn == WHITE) ? BLACK : WHITE; // Switch the turn to the other player
-    return true; // Return true to indicate the move was successful
+// Method to set the position to a snapshot and keep the hashes of the positions that led to it
+void ChessGame::restore(const BoardState& boardState, const vector<uint64_t>& keys) {
+    restore(boardState);
+    earlierKeys = keys;
 }
 
+// Helper function to find the hash of a position of the game, in the history or before it
+uint64_t ChessGame::keyAtPly(int ply) const {
+    return (ply >= 0) ? history[ply].key : earlierKeys[earlierKeys.size() + ply];
+}
 
-// General check for the move (e.g., turn color, valid position, from-to cannot be the same)
-bool ChessGame::initialCheck(const Position& from, const Position& to) const{
-    // Get the piece at the source position
-    ChessPiece* piece = getPieceAt(from);
-  
-    // Check if there is no piece at the source position
-    if (piece == nullptr) {
-        cout << "There is no piece at position " << from << "!" << endl;
-        return false; 
+// Method to check if the position already occurred earlier in the game, with the same player to move.
+// Only positions since the last capture or pawn move can match, and at least four plies are needed to return to one.
+bool ChessGame::isRepetition() const {
+    int ply = history.size();
+    int oldest = max(-int(earlierKeys.size()), ply - state.halfmoveClock);
+    for (int i = ply - 4; i >= oldest; i -= 2) {
+        if (keyAtPly(i) == state.positionKey) {
+            return true;
+        }
     }
+    return false;
+}
 
-    // Check if the moving piece belongs to the cuurent player
-    if (piece->getColor() != currentTurn) {
-        cout << "It is not " << (currentTurn == WHITE ? "Black's" : "White's") << " turn to move!" << endl;
-        return false;
+// Helper function to count the occurrences of the position with the same player to move.
+// Like isRepetition, it only looks back to the last capture or pawn move, which no position before it can match.
+int ChessGame::repetitionCount() const {
+    int ply = history.size();
+    int oldest = max(-int(earlierKeys.size()), ply - state.halfmoveClock);
+    int count = 1;
+    for (int i = ply - 4; i >= oldest; i -= 2) {
+        if (keyAtPly(i) == state.positionKey) {
+            ++count;
+        }
     }
+    return count;
+}
 
-    // Check if both positions are valid
-    if (!from.isValid() || !to.isValid()) {
-        printInvalidMoveMessage(piece, to);
+// Helper function to check if neither side has the pieces left to checkmate: bare kings, a single minor piece,
+// or bishops that all stand on squares of the same color
+bool ChessGame::hasInsufficientMaterial() const {
+    Bitboard heavy = state.pieces[W_PAWN] | state.pieces[B_PAWN] | state.pieces[W_ROOK] | state.pieces[B_ROOK]
+                   | state.pieces[W_QUEEN] | state.pieces[B_QUEEN];
+    if (heavy) {
         return false;
     }
+    Bitboard knights = state.pieces[W_KNIGHT] | state.pieces[B_KNIGHT];
+    Bitboard bishops = state.pieces[W_BISHOP] | state.pieces[B_BISHOP];
+    if (popCount(knights | bishops) <= 1) {
+        return true;
+    }
+    return !knights && (!(bishops & DARK_SQUARES_BB) || !(bishops & ~DARK_SQUARES_BB));
+}
 
-    // Check if both positions are the same
-    if (from == to) {
-        printInvalidMoveMessage(piece, to);
-        return false;
-    }  
-    return true;
+// Getter for the number of halfmoves since the last capture or pawn move
+int ChessGame::getHalfmoveClock() const {
+    return state.halfmoveClock;
 }
 
-// Method to check if the path between 'from' and 'to' is clear (i.e., no pieces in the way)
-bool ChessGame::isPathClear(const Position& from, const Position& to) const {
-    // Determine the direction of movement for rows and columns
-    int rowDiff = to.getRow() - from.getRow();
-    int colDiff = to.getCol() - from.getCol();
-    
-    // Calculate the direction of movement: +1, -1, or 0
-    int rowDirection = (rowDiff != 0) ? rowDiff / abs(rowDiff) : 0;
-    int colDirection = (colDiff != 0) ? colDiff / abs(colDiff) : 0;
-
-    // Start from the next position in the direction of movement
-    int currentRow = from.getRow() + rowDirection;
-    int currentCol = from.getCol() + colDirection;
-
-    // Traverse the path from 'from' to 'to' but stop before reaching 'to'
-    while (currentRow != to.getRow() || currentCol != to.getCol()) {
-        // If there is a piece at the current position, the path is blocked
-        if (board[currentRow][currentCol] != nullptr) {
-            return false; // The path is blocked by another piece
-        }
-        // Move to the next position in the direction of movement
-        currentRow += rowDirection;
-        currentCol += colDirection;
+// Getter for the Zobrist hash of the pawns
+uint64_t ChessGame::getPawnKey() const {
+    return state.pawnKey;
+}
+
+// Getter for the undo records of the moves played since the state was loaded
+const UndoStack& ChessGame::getHistory() const {
+    return history;
+}
+
+// Getter for the material and piece-square score of the position
+Score ChessGame::getPieceSquareScore() const {
+    return state.pieceSquareScore;
+}
+
+// Getter for the game phase of the pieces on the board
+int ChessGame::getPhase() const {
+    return state.phase;
+}
+
+// Method to evaluate the position, from the point of view of the player to move
+int ChessGame::evaluate() const {
+    return ::evaluate(*this);
+}
+
+// Getter for the en passant square
+int ChessGame::getEnPassantSquare() const {
+    return state.enPassantSquare;
+}
+
+// Getter for the castling rights
+uint8_t ChessGame::getCastlingRights() const {
+    return state.castlingRights;
+}
+
+// Setter for the observer of the game
+void ChessGame::setObserver(GameObserver* gameObserver) {
+    observer = gameObserver;
+}
+
+// Getter for the player whose turn it is
+Color ChessGame::getCurrentTurn() const {
+    return state.currentTurn;
+}
+
+// Getter for the bitboard of the pieces of one color and type
+Bitboard ChessGame::getPieces(Color color, PieceType type) const {
+    return state.pieces[pieceIndex(color, type)];
+}
+
+// Getter for the bitboard of all pieces of one color
+Bitboard ChessGame::getOccupancy(Color color) const {
+    return state.occupancy[color];
+}
+
+// Method to attach (or detach with nullptr) a transposition table
+void ChessGame::setTranspositionTable(TranspositionTable* table) {
+    transpositionTable = table;
+}
+
+// Method to find the game-end status of the player to move.
+// Checkmate and stalemate come first, since they end the game even on the move that would draw it. The draws are
+// checked next from the state kept up to date by makeMove: the halfmove clock, the hashes in the undo records and
+// the piece bitboards, so none of them costs more than a few instructions or a short scan of the history.
+GameStatus ChessGame::getGameStatus() const {
+    GameStatus status = positionStatus();
+    if (status == CHECKMATE || status == STALEMATE) {
+        return status;
     }
-    // If we reach here, it means there were no pieces blocking the path
-    return true; // The path is clear
+    GameStatus draw = drawStatus();
+    return (draw != ONGOING) ? draw : status;
 }
 
-// Method to check if a king is in check
-bool ChessGame::isKingInCheck(Color kingColor) const {
-    Position kingPosition;
-    bool kingFound = false; // Flag to check if king is found
+// Method to find whether the game is drawn by insufficient material, the move-count rules or repetition.
+// The seventy-five-move rule and fivefold repetition end the game by themselves, so they are reported before the
+// fifty-move rule and threefold repetition they imply. None of them needs the legal moves, so this is much cheaper
+// than getGameStatus.
+GameStatus ChessGame::drawStatus() const {
+    if (hasInsufficientMaterial()) {
+        return INSUFFICIENT_MATERIAL;
+    }
+    if (state.halfmoveClock >= 150) {
+        return SEVENTY_FIVE_MOVE_DRAW;
+    }
+    int repetitions = repetitionCount();
+    if (repetitions >= 5) {
+        return FIVEFOLD_REPETITION;
+    }
+    if (state.halfmoveClock >= 100) {
+        return FIFTY_MOVE_DRAW;
+    }
+    if (repetitions >= 3) {
+        return THREEFOLD_REPETITION;
+    }
+    return ONGOING;
+}
 
-    // Find the king's position
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            ChessPiece* piece = board[row][col];
-            if (piece != nullptr && piece->getSymbol() == 'K' && piece->getColor() == kingColor) {
-                kingPosition = Position(row, col);
-                kingFound = true; // Set flag to true once the king is found
-                break;
-            }
+// Helper function to find whether the player to move is in check, checkmate, stalemate or none of them.
+// The result only depends on the position, so a transposition table hit skips the legal move search entirely.
+GameStatus ChessGame::positionStatus() const {
+    GameStatus status;
+    if (transpositionTable != nullptr && transpositionTable->probeStatus(state.positionKey, status)) {
+        return status;
+    }
+
+    LegalityInfo info = legalityInfo(state.currentTurn);
+    bool inCheck = (info.checkers != 0);
+    bool canMove = hasLegalMove(state.currentTurn, info);
+    if (inCheck) {
+        status = canMove ? CHECK : CHECKMATE;
+    } else {
+        status = canMove ? ONGOING : STALEMATE;
+    }
+
+    if (transpositionTable != nullptr) {
+        transpositionTable->storeStatus(state.positionKey, status);
+    }
+    return status;
+}
+
+// Helper function to hash the pawns from scratch
+uint64_t ChessGame::computePawnKey() const {
+    uint64_t key = 0;
+    for (Piece pawn : {W_PAWN, B_PAWN}) {
+        Bitboard bb = state.pieces[pawn];
+        while (bb) {
+            key ^= ZobristPieces[pawn][popLsb(bb)];
         }
-        if (kingFound) break; // If king is found, exit the outer loop as well
     }
+    return key;
+}
 
-    // Check if any opposing piece can attack the king's position
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            ChessPiece* piece = board[row][col];
-            if (piece != nullptr && piece->getColor() != kingColor) { // Check if the piece is an opponent's
-                Position from(row, col);
-
-                if (piece->isValidMove(from, kingPosition, *this)) {
-                    // Only check isPathClear for Rook, Bishop, and Queen
-                    if (piece->getSymbol() == 'R' || piece->getSymbol() == 'B' || piece->getSymbol() == 'Q') {
-                        if (!isPathClear(from, kingPosition)) {
-                            continue; // Path is blocked; move is invalid
-                        }
-                    }
-                    return true; // Valid attack
-                }
-            }
+// Helper function to hash the position from scratch, used when a new state is loaded
+uint64_t ChessGame::computeKey() const {
+    uint64_t key = 0;
+    for (int piece = 0; piece < 2 * PIECE_TYPE_NB; ++piece) {
+        Bitboard bb = state.pieces[piece];
+        while (bb) {
+            key ^= ZobristPieces[piece][popLsb(bb)];
         }
     }
-    return false; // King is not in check
+    key ^= ZobristCastling[state.castlingRights];
+    if (state.enPassantSquare != NO_SQUARE) {
+        key ^= ZobristEnPassant[fileOf(state.enPassantSquare)];
+    }
+    if (state.currentTurn == BLACK) {
+        key ^= ZobristSide;
+    }
+    return key;
 }
 
+// Helper function to check if a player still holds the castling right for one side
+bool ChessGame::hasCastlingRight(Color color, bool isKingSide) const {
+    return (state.castlingRights & castlingRightOf(color, isKingSide)) != 0;
+}
 
-// Method to check if the king is in checkmate
-bool ChessGame::isCheckmate(Color kingColor) {
-    // Iterate through all pieces of the given color to find any valid move
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            ChessPiece* piece = board[row][col];
-            if (piece != nullptr && piece->getColor() == kingColor) {
-                Position from(row, col);
-                
-                // Try all possible moves for the piece
-                for (int r = 0; r < 8; ++r) {
-                    for (int c = 0; c < 8; ++c) {
-                        Position to(r, c);
-
-                        // Check if the move is valid for the piece
-                        if (piece->isValidMove(from, to, *this) && from!=to) {
-                            // Additional path check for specific pieces to have clear path (Bishop, Rook, Queen)
-                            if ((piece->getSymbol() == 'R' || piece->getSymbol() == 'B' || piece->getSymbol() == 'Q') && !isPathClear(from, to)) {
-                                continue;
-                            }
-                            // Check if the destination position is occupied by the current player's piece
-                            ChessPiece* capturedPiece = board[r][c];
-                            if (capturedPiece != nullptr && capturedPiece->getColor() == piece->getColor()) {
-                                continue;
-                            }
-                            
-                            // Temporarily make the move
-                            board[r][c] = piece;
-                            board[row][col] = nullptr;
-
-                            // Check if the move puts the current player's king in check 
-                            bool kingInCheck = isKingInCheck(kingColor);
-                            
-                            // Undo the move
-                            board[row][col] = piece;
-                            board[r][c] = capturedPiece;
-
-                            // If any move can prevent the king from being in check, it is not checkmate
-                            if (!kingInCheck) {
-                                return false;
-                            }
-                        }
-                    }
+// Helper function to check if a player can make at least one legal move, stopping at the first one found
+bool ChessGame::hasLegalMove(Color color, const LegalityInfo& info) const {
+    MoveList pseudoLegalMoves;
+    generatePseudoLegalMoves(color, pseudoLegalMoves, false);
+
+    for (const ChessMove& move : pseudoLegalMoves) {
+        if (isLegal(move, info)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Helper function to generate the moves that follow each piece's moving rule, without checking the king's safety
+void ChessGame::generatePseudoLegalMoves(Color color, MoveList& moves, bool capturesOnly) const {
+    Color opponentColor = (color == WHITE) ? BLACK : WHITE;
+    Bitboard occupied = state.occupancy[WHITE] | state.occupancy[BLACK];
+
+    // Pieces may move to empty squares or capture opponent's pieces
+    Bitboard targets = capturesOnly ? state.occupancy[opponentColor] : ~state.occupancy[color];
+
+    // Pawns move forward one square, or two from their initial rank, and capture diagonally, en passant included.
+    // A pawn reaching the last rank promotes, so each of those moves is generated once per promotion piece;
+    // promotions count as captures, since they change the material as much.
+    int forward = (color == WHITE) ? 8 : -8;
+    Bitboard initialRank = (color == WHITE) ? (RANK_1_BB << 8) : (RANK_8_BB >> 8);
+    Bitboard lastRank = (color == WHITE) ? RANK_8_BB : RANK_1_BB;
+    Bitboard pawns = state.pieces[pieceIndex(color, PAWN)];
+    while (pawns) {
+        int from = popLsb(pawns);
+        int to = from + forward;
+        if (to >= 0 && to < SQUARE_NB && !(occupied & squareBB(to))) {
+            if (lastRank & squareBB(to)) {
+                addPromotions(from, to, moves);
+            } else if (!capturesOnly) {
+                moves.add(ChessMove(from, to));
+                if ((initialRank & squareBB(from)) && !(occupied & squareBB(to + forward))) {
+                    moves.add(ChessMove(from, to + forward));
                 }
             }
         }
+        Bitboard captures = pawnAttacks(color, from) & state.occupancy[opponentColor];
+        while (captures) {
+            int target = popLsb(captures);
+            if (lastRank & squareBB(target)) {
+                addPromotions(from, target, moves);
+            } else {
+                moves.add(ChessMove(from, target));
+            }
+        }
+        if (color == state.currentTurn && state.enPassantSquare != NO_SQUARE
+            && (pawnAttacks(color, from) & squareBB(state.enPassantSquare))) {
+            moves.add(ChessMove(from, state.enPassantSquare, EN_PASSANT));
+        }
+    }
+
+    // Knights, bishops, rooks, queens and the king move to the squares they attack
+    for (int type = KNIGHT; type <= KING; ++type) {
+        Bitboard movers = state.pieces[pieceIndex(color, PieceType(type))];
+        while (movers) {
+            int from = popLsb(movers);
+            Bitboard attacks = attacksOf(PieceType(type), from, occupied) & targets;
+            while (attacks) {
+                moves.add(ChessMove(from, popLsb(attacks)));
+            }
+        }
+    }
+
+    // Castling moves, on both sides
+    for (int side = 0; side < 2 && !capturesOnly; ++side) {
+        bool isKingSide = (side == 0);
+        if (canCastle(color, isKingSide)) {
+            int kingSquare = (color == WHITE) ? 4 : 60;
+            moves.add(ChessMove(kingSquare, kingSquare + (isKingSide ? 2 : -2), CASTLING));
+        }
     }
-    return true; // If no valid moves prevent check, then it's checkmate
 }
 
-// Method to check if there is a stalemate
-bool ChessGame::isStalemate(Color color) {
-    if (isKingInCheck(color)) {
-        return false; // If it's in a check, then it must not a Stalemate
+// Helper function to add the four promotions of a pawn move, the queen first
+void ChessGame::addPromotions(int from, int to, MoveList& moves) {
+    for (int type = QUEEN; type >= KNIGHT; --type) {
+        moves.add(ChessMove(from, to, PROMOTION, PieceType(type)));
     }
+}
 
-    // Iterate through all pieces of the given color
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            ChessPiece* piece = board[row][col];
-            if (piece != nullptr && piece->getColor() == color) {
-                Position from(row, col);
-                // Try all possible moves for the piece
-                for (int r = 0; r < 8; ++r) {
-                    for (int c = 0; c < 8; ++c) {
-                        Position to(r, c);
-                        if (piece->isValidMove(from, to, *this)) {
-                            // Temporarily make the move and check if it lead to a check
-                            ChessPiece* capturedPiece = board[r][c];
-                            board[r][c] = piece;
-                            board[row][col] = nullptr;
-
-                            bool kingInCheck = isKingInCheck(color);
-
-                            // Undo the move
-                            board[row][col] = piece;
-                            board[r][c] = capturedPiece;
-
-                            if (!kingInCheck) {
-                                return false; // If there is a move that does not lead to a check, then it is not a stalmate
-                            }
-                        }
-                    }
-                }
-            }
+// Helper function to check if a player may castle on the given side.
+// The player must hold the castling right, the king and the rook must be on their original squares, every square
+// between them must be empty, and the king must not be in check or pass through or land on a threatened square.
+// makeMove clears the right as soon as the king or the rook moves or the rook is captured, so the right alone
+// tells whether they have moved.
+bool ChessGame::canCastle(Color color, bool isKingSide) const {
+    int kingSquare = (color == WHITE) ? 4 : 60;
+    int rookSquare = kingSquare + (isKingSide ? 3 : -4);
+    Color opponentColor = (color == WHITE) ? BLACK : WHITE;
+
+    if (!hasCastlingRight(color, isKingSide)) {
+        return false;
+    }
+    if (!(state.pieces[pieceIndex(color, KING)] & squareBB(kingSquare)) || !(state.pieces[pieceIndex(color, ROOK)] & squareBB(rookSquare))) {
+        return false;
+    }
+    if (betweenBB(kingSquare, rookSquare) & (state.occupancy[WHITE] | state.occupancy[BLACK])) {
+        return false;
+    }
+
+    int direction = isKingSide ? 1 : -1;
+    return !isSquareAttacked(kingSquare, opponentColor)
+        && !isSquareAttacked(kingSquare + direction, opponentColor)
+        && !isSquareAttacked(kingSquare + 2 * direction, opponentColor);
+}
+
+// Helper function to find what decides the legality of a player's moves in the current position.
+// The pinned pieces are found from the opponent's sliders that would attack the king on an empty board: a slider
+// with exactly one piece between it and the king pins that piece if it belongs to the player.
+LegalityInfo ChessGame::legalityInfo(Color color) const {
+    LegalityInfo info;
+    Bitboard king = state.pieces[pieceIndex(color, KING)];
+    if (king == 0) {
+        // Without a king on the board every move is safe
+        info.kingSquare = NO_SQUARE;
+        info.checkers = info.pinned = 0;
+        info.checkMask = ~Bitboard(0);
+        return info;
+    }
+
+    Color opponentColor = (color == WHITE) ? BLACK : WHITE;
+    Bitboard occupied = state.occupancy[WHITE] | state.occupancy[BLACK];
+    info.kingSquare = lsb(king);
+    info.checkers = attackersTo(info.kingSquare, occupied) & state.occupancy[opponentColor];
+    if (info.checkers == 0) {
+        info.checkMask = ~Bitboard(0);
+    } else if ((info.checkers & (info.checkers - 1)) == 0) {
+        info.checkMask = info.checkers | betweenBB(info.kingSquare, lsb(info.checkers));
+    } else {
+        info.checkMask = 0; // In double check only the king may move
+    }
+
+    Bitboard queens = state.pieces[pieceIndex(opponentColor, QUEEN)];
+    Bitboard snipers = (rookAttacks(info.kingSquare, 0) & (state.pieces[pieceIndex(opponentColor, ROOK)] | queens))
+                     | (bishopAttacks(info.kingSquare, 0) & (state.pieces[pieceIndex(opponentColor, BISHOP)] | queens));
+    info.pinned = 0;
+    while (snipers) {
+        Bitboard blockers = betweenBB(info.kingSquare, popLsb(snipers)) & occupied;
+        if (blockers && (blockers & (blockers - 1)) == 0) {
+            info.pinned |= blockers & state.occupancy[color];
         }
     }
-    return true; // If there is no any valid move, then it is a stalmate
+    return info;
 }
 
+// Helper function to check if a pseudo-legal move keeps the moving player's king out of check.
+// Any other move is legal when it ends on the check mask and, for a pinned piece, stays on the line of its pin.
+// A king move is legal when its destination is not attacked once the king has left its square, so that a slider
+// checking along the line still covers the square behind it. An en passant capture removes two pawns from a line
+// at once, so it is tested on the board as it would be after the move.
+bool ChessGame::isLegal(const ChessMove& move, const LegalityInfo& info) const {
+    if (move.getType() == CASTLING || info.kingSquare == NO_SQUARE) {
+        return true; // Castling is only generated when the king's path is safe
+    }
 
-// Function to validate and execute castling
-bool ChessGame::performCastling(const Position& from, const Position& to) {
-    // Get the piece to be moved
-    ChessPiece* piece = getPieceAt(from);
+    int from = move.getFrom();
+    int to = move.getTo();
+    Color color = (state.occupancy[WHITE] & squareBB(from)) ? WHITE : BLACK;
+    Color opponentColor = (color == WHITE) ? BLACK : WHITE;
+    Bitboard occupied = state.occupancy[WHITE] | state.occupancy[BLACK];
 
-    // Ensure the piece is a king
-    if (piece->getSymbol() != 'K') {
+    if (from == info.kingSquare) {
+        return (attackersTo(to, occupied ^ squareBB(from)) & state.occupancy[opponentColor]) == 0;
+    }
+    if (move.getType() == EN_PASSANT) {
+        Bitboard captured = squareBB(to + ((color == WHITE) ? -8 : 8));
+        occupied = (occupied ^ squareBB(from) ^ captured) | squareBB(to);
+        return (attackersTo(info.kingSquare, occupied) & state.occupancy[opponentColor] & ~captured) == 0;
+    }
+    if (!(info.checkMask & squareBB(to))) {
         return false;
     }
+    return !(info.pinned & squareBB(from)) || (lineBB(info.kingSquare, from) & squareBB(to));
+}
+
+// Helper function to find the pieces of both colors attacking a square, for the given occupied squares
+Bitboard ChessGame::attackersTo(int square, Bitboard occupied) const {
+    Bitboard bishopsQueens = state.pieces[pieceIndex(WHITE, BISHOP)] | state.pieces[pieceIndex(BLACK, BISHOP)]
+                           | state.pieces[pieceIndex(WHITE, QUEEN)] | state.pieces[pieceIndex(BLACK, QUEEN)];
+    Bitboard rooksQueens = state.pieces[pieceIndex(WHITE, ROOK)] | state.pieces[pieceIndex(BLACK, ROOK)]
+                         | state.pieces[pieceIndex(WHITE, QUEEN)] | state.pieces[pieceIndex(BLACK, QUEEN)];
+
+    return (pawnAttacks(BLACK, square) & state.pieces[pieceIndex(WHITE, PAWN)])
+         | (pawnAttacks(WHITE, square) & state.pieces[pieceIndex(BLACK, PAWN)])
+         | (knightAttacks(square) & (state.pieces[pieceIndex(WHITE, KNIGHT)] | state.pieces[pieceIndex(BLACK, KNIGHT)]))
+         | (kingAttacks(square) & (state.pieces[pieceIndex(WHITE, KING)] | state.pieces[pieceIndex(BLACK, KING)]))
+         | (bishopAttacks(square, occupied) & bishopsQueens)
+         | (rookAttacks(square, occupied) & rooksQueens);
+}
+
+
+// Function to validate and execute castling
+MoveOutcome ChessGame::performCastling(const Position& from, const Position& to) {
+    // Get the piece to be moved
+    Piece piece = pieceOn(squareOf(from));
+    Color color = colorOf(piece);
 
     // Determine if this is king-side or queen-side castling
     bool isKingSide = (to.getCol() > from.getCol());
 
-    // Define rook's current and target positions
+    // Define rook's current position
     Position rookPos = isKingSide ? Position(from.getRow(), 7) : Position(from.getRow(), 0);
-    Position rookTargetPos = isKingSide ? Position(from.getRow(), 5) : Position(from.getRow(), 3);
-
-    ChessPiece* rook = getPieceAt(rookPos);
 
-    // Verify castling conditions: king and rook must not have moved
-    King* kingPtr = dynamic_cast<King*>(piece);
-    if (kingPtr == nullptr || kingPtr->hasMovedBefore()) {
-        cout << "Invalid castling move: king condition not met." << endl;
-        return false;
+    // Verify castling conditions: the king must stand on its original square and stay on its rank,
+    // and a rook of the same color must stand on the corner it castles with
+    int kingHomeSquare = (color == WHITE) ? 4 : 60;
+    if (typeOf(piece) != KING || squareOf(from) != kingHomeSquare || to.getRow() != from.getRow()) {
+        return CASTLING_KING_MOVED;
+    }
+    if (pieceOn(squareOf(rookPos)) != makePiece(color, ROOK)) {
+        return CASTLING_ROOK_MOVED;
     }
 
-    Rook* rookPtr = dynamic_cast<Rook*>(rook);
-    if (rookPtr == nullptr || rookPtr->hasMovedBefore()) {
-        cout << "Invalid castling move: rook condition not met." << endl;
-        return false;
+    // Verify that the player still holds the castling right for this side, which is lost once the king or the rook moves
+    if (!hasCastlingRight(color, isKingSide)) {
+        return CASTLING_RIGHT_LOST;
     }
 
     // Check if the king is currently in check
-    if (isKingInCheck(piece->getColor())) {
-        cout << "Cannot castle while in check." << endl;
-        return false;
+    if (isKingInCheck(color)) {
+        return CASTLING_IN_CHECK;
     }
 
-    // Verify that the path is clear and safe for the king
+    // Verify that the path between the king and the rook is clear and that the king's path is safe
+    Color opponentColor = (color == WHITE) ? BLACK : WHITE;
     int direction = isKingSide ? 1 : -1;
     for (int col = from.getCol() + direction; col != to.getCol() + direction; col += direction) {
         Position intermediatePos(from.getRow(), col);
-        if (isOccupied(intermediatePos) || 
-            (col != rookPos.getCol() && isKingInCheckAfterMove(from, intermediatePos))) {
-            cout << "Invalid castling move: path not clear or king passes through threatened square." << endl;
-            return false;
+        if (!isPathClear(from, rookPos) || isSquareAttacked(squareOf(intermediatePos), opponentColor)) {
+            return CASTLING_PATH_BLOCKED;
         }
     }
 
-    // Execute the castling move
-    board[to.getRow()][to.getCol()] = piece;
-    board[from.getRow()][from.getCol()] = nullptr;
-    board[rookTargetPos.getRow()][rookTargetPos.getCol()] = rook;
-    board[rookPos.getRow()][rookPos.getCol()] = nullptr;
-
-    // Mark both the king and rook as having moved
-    kingPtr->setMoved();
-    rookPtr->setMoved();
-
-    cout << "Castling move performed" << endl;
-    return true;
+    // Execute the castling move, which moves both the king and the rook and clears the player's castling rights
+    makeMove(ChessMove(squareOf(from), squareOf(to), CASTLING));
+    return MOVE_OK;
 }
 
 
 //Method to check if a king will be in check when performing castling
 bool ChessGame::isKingInCheckAfterMove(const Position& from, const Position& to) {
-    // Store the original piece at the destination
-    ChessPiece* originalPiece = board[to.getRow()][to.getCol()];
-    ChessPiece* movingPiece = board[from.getRow()][from.getCol()];
-
-    // Temporarily make the move
-    board[to.getRow()][to.getCol()] = movingPiece;
-    board[from.getRow()][from.getCol()] = nullptr;
+    int fromSquare = squareOf(from);
+    int toSquare = squareOf(to);
 
     // Determine the color of the king being checked
-    Color kingColor = movingPiece->getColor();
+    Color kingColor = (state.occupancy[WHITE] & squareBB(fromSquare)) ? WHITE : BLACK;
+
+    // Temporarily make the move
+    PieceType capturedType;
+    relocatePiece(fromSquare, toSquare, capturedType);
 
     // Check if the move leads to the king being in check
     bool inCheck = isKingInCheck(kingColor);
 
     // Undo the move
-    board[from.getRow()][from.getCol()] = movingPiece;
-    board[to.getRow()][to.getCol()] = originalPiece;
+    revertRelocation(fromSquare, toSquare, capturedType);
 
     return inCheck;
 }
 
-// Method to print the current state of the chessboard(not required by Spec, but useful for checking)
-void ChessGame::printBoard() const{
+// Method to draw the chessboard as text (not required by Spec, but useful for checking)
+string ChessGame::toString() const {
+    const char symbols[PIECE_TYPE_NB] = {'P', 'N', 'B', 'R', 'Q', 'K'}; // Symbols indexed by PieceType
+    string text;
+    text.reserve(8 * 17);
     for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) { 
-            if (board[row][col] == nullptr) { // If there is no piece at the current position
-                cout << ". "; // Print a dot to indicate an empty square
+        for (int col = 0; col < 8; ++col) {
+            int square = squareOf(Position(row, col));
+            PieceType type = pieceTypeOn(square);
+            if (type == PIECE_TYPE_NB) { // If there is no piece at the current position
+                text += '.'; // A dot stands for an empty square
+            } else if (state.occupancy[WHITE] & squareBB(square)) {
+                text += symbols[type]; // White pieces in uppercase
             } else {
-                char symbol = board[row][col]->getSymbol();
-                if (board[row][col]->getColor() == WHITE) {
-                    cout << static_cast<char>(toupper(symbol)) << " "; // Print white pieces in uppercase
-                } else {
-                    cout << static_cast<char>(tolower(symbol)) << " "; // Print black pieces in lowercase
-                }
-            }   
+                text += char(tolower(symbols[type])); // Black pieces in lowercase
+            }
+            text += (col < 7) ? ' ' : '\n';
         }
-        cout << endl; // Move to the next line after each row
     }
+    return text;
 }
 
 
 // Helper function to clear the board
 void ChessGame::clearBoard() {
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            delete board[row][col];
-            board[row][col] = nullptr;
-        }
+    for (int square = 0; square < SQUARE_NB; ++square) {
+        board[square] = NO_PIECE;
     }
-}
-
-// Helper function to print invalid move messages
-void ChessGame::printInvalidMoveMessage(const ChessPiece* piece, const Position& to) const {
-    cout << (piece->getColor() == WHITE ? "White's " : "Black's ") << piece->getName() << " cannot move to " << to << "!" << endl;
+    history.clear();
+    earlierKeys.clear();
+    for (int i = 0; i < 2 * PIECE_TYPE_NB; ++i) {
+        state.pieces[i] = 0;
+    }
+    state.occupancy[WHITE] = state.occupancy[BLACK] = 0;
+    state.pieceSquareScore = 0;
+    state.phase = 0;
 }
 
 // Helper function to check if a position is occupied
 bool ChessGame::isOccupied(const Position& pos) const {
-    return board[pos.getRow()][pos.getCol()] != nullptr;
+    return ((state.occupancy[WHITE] | state.occupancy[BLACK]) & squareBB(squareOf(pos))) != 0;
 }
 
 // Helper function to get the piece at a given position
-ChessPiece* ChessGame::getPieceAt(const Position& pos) const {
-    return board[pos.getRow()][pos.getCol()];
+const ChessPiece* ChessGame::getPieceAt(const Position& pos) const {
+    if (!pos.isValid()) {
+        return nullptr; // There is no piece outside the board
+    }
+    return pieceObject(board[squareOf(pos)]);
+}
+
+// Helper function to place a piece on an empty square
+void ChessGame::putPiece(Piece piece, int square) {
+    state.pieces[piece] |= squareBB(square);
+    state.occupancy[colorOf(piece)] |= squareBB(square);
+    state.pieceSquareScore += PieceSquareScores[piece][square];
+    state.phase += PiecePhase[piece];
+    board[square] = piece;
+}
+
+// Helper function to take a piece off its square, updating both the bitboards and the board
+void ChessGame::removePiece(int square) {
+    Piece piece = board[square];
+    state.pieces[piece] ^= squareBB(square);
+    state.occupancy[colorOf(piece)] ^= squareBB(square);
+    state.pieceSquareScore -= PieceSquareScores[piece][square];
+    state.phase -= PiecePhase[piece];
+    board[square] = NO_PIECE;
+}
+
+// Helper function to move a piece, removing whatever stands on the destination square
+void ChessGame::relocatePiece(int from, int to, PieceType& capturedType) {
+    Piece piece = board[from];
+    Piece captured = board[to];
+    capturedType = typeOf(captured);
+
+    // Remove the captured piece from the opponent's bitboards
+    if (captured != NO_PIECE) {
+        state.pieces[captured] ^= squareBB(to);
+        state.occupancy[colorOf(captured)] ^= squareBB(to);
+        state.pieceSquareScore -= PieceSquareScores[captured][to];
+        state.phase -= PiecePhase[captured];
+    }
+
+    // Move the piece's bit from 'from' to 'to'
+    Bitboard fromTo = squareBB(from) | squareBB(to);
+    state.pieces[piece] ^= fromTo;
+    state.occupancy[colorOf(piece)] ^= fromTo;
+    state.pieceSquareScore += PieceSquareScores[piece][to] - PieceSquareScores[piece][from];
+
+    board[to] = piece;
+    board[from] = NO_PIECE;
+}
+
+// Helper function to take back a move made by relocatePiece
+void ChessGame::revertRelocation(int from, int to, PieceType capturedType) {
+    Piece piece = board[to];
+    Color color = colorOf(piece);
+    Color opponentColor = (color == WHITE) ? BLACK : WHITE;
+
+    // Move the piece's bit back from 'to' to 'from'
+    Bitboard fromTo = squareBB(from) | squareBB(to);
+    state.pieces[piece] ^= fromTo;
+    state.occupancy[color] ^= fromTo;
+    state.pieceSquareScore += PieceSquareScores[piece][from] - PieceSquareScores[piece][to];
+    board[from] = piece;
+    board[to] = NO_PIECE;
+
+    // Restore the captured piece
+    if (capturedType != PIECE_TYPE_NB) {
+        putPiece(makePiece(opponentColor, capturedType), to);
+    }
+}
+
+// Helper function to find the type of the piece standing on a square
+PieceType ChessGame::pieceTypeOn(int square) const {
+    return typeOf(board[square]);
+}
+
+// Helper function to find the piece standing on a square
+Piece ChessGame::pieceOn(int square) const {
+    return board[square];
+}
+
+// Helper function to find the squares the piece on a square may move to by its moving rule.
+// Pawns move forward one square, or two from their initial rank, onto empty squares and capture diagonally,
+// on the en passant square too; the other pieces move to the squares they attack that do not hold a piece of their own color.
+Bitboard ChessGame::targetsFrom(int square) const {
+    Piece piece = board[square];
+    Color color = colorOf(piece);
+    Color opponentColor = (color == WHITE) ? BLACK : WHITE;
+    Bitboard occupied = state.occupancy[WHITE] | state.occupancy[BLACK];
+
+    if (typeOf(piece) != PAWN) {
+        return attacksOf(typeOf(piece), square, occupied) & ~state.occupancy[color];
+    }
+
+    Bitboard enemies = state.occupancy[opponentColor];
+    if (state.enPassantSquare != NO_SQUARE && color == state.currentTurn) {
+        enemies |= squareBB(state.enPassantSquare);
+    }
+    Bitboard targets = pawnAttacks(color, square) & enemies;
+    int forward = (color == WHITE) ? 8 : -8;
+    int to = square + forward;
+    if (to >= 0 && to < SQUARE_NB && !(occupied & squareBB(to))) {
+        targets |= squareBB(to);
+        Bitboard initialRank = (color == WHITE) ? (RANK_1_BB << 8) : (RANK_8_BB >> 8);
+        if ((initialRank & squareBB(square)) && !(occupied & squareBB(to + forward))) {
+            targets |= squareBB(to + forward);
+        }
+    }
+    return targets;
 }
\ No newline at end of file
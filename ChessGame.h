@@ -6,37 +6,287 @@
 
 #include "Position.h"
 #include "Color.h"
+#include "Bitboard.h"
+#include "Piece.h"
+#include "ChessMove.h"
+#include "GameStatus.h"
+#include "Fen.h"
+#include "MoveResult.h"
+#include "UndoStack.h"
+#include "Evaluation.h"
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
 class ChessPiece;
+class TranspositionTable;
+class GameObserver;
+
+// Marks the absence of an en passant square
+const int NO_SQUARE = -1;
+
+// FEN of the standard starting position
+const char* const START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+// BoardState holds everything that defines a position: the pieces, the player to move, the castling flags,
+// the en passant square, the move clocks and the hash. It is a plain value without pointers, so a position can be
+// copied with a single assignment, handed to another thread or stored by the thousand without touching the heap.
+struct BoardState {
+    // Bitboards of the pieces of each color and type, indexed by pieceIndex(color, type) or by Piece.
+    // Together with the occupancy bitboards, they are the authoritative state of the board.
+    Bitboard pieces[2 * PIECE_TYPE_NB];
+
+    // Bitboards of all the squares occupied by each color
+    Bitboard occupancy[2];
+
+    // Zobrist hash of the position, updated incrementally by every move
+    uint64_t positionKey;
+
+    // Zobrist hash of the pawns alone, which keys the pawn structure cache of the evaluation
+    uint64_t pawnKey;
+
+    // Sum of the material and piece-square scores of all pieces, and the game phase of the pieces on the board,
+    // both updated whenever a piece is put on or taken off a square
+    Score pieceSquareScore;
+    int phase;
+
+    // Represents the current player's turn, either WHITE or BLACK
+    Color currentTurn;
+
+    // Mask of the CastlingRight bits still held. Each move clears the rights of the squares it touches,
+    // so the mask alone tells whether a king or a rook has moved.
+    uint8_t castlingRights;
+
+    // Square a pawn skipped over with a two-square move on the last ply, or NO_SQUARE
+    int enPassantSquare;
+
+    // Number of halfmoves since the last capture or pawn move
+    int halfmoveClock;
+
+    // Number of the full move, starting at 1 and incremented after each of Black's moves
+    int fullmoveNumber;
+};
+
+// LegalityInfo holds what decides the legality of a player's moves in one position, worked out once so that most
+// moves are proven legal with two bitboard tests instead of being tried on the board
+struct LegalityInfo {
+    int kingSquare;     // Square of the player's king, or NO_SQUARE if there is none
+    Bitboard checkers;  // Opponent pieces giving check to the king
+    Bitboard checkMask; // Squares a move other than a king move must end on: every square when not in check, the
+                        // checker and the squares between it and the king in single check, none in double check
+    Bitboard pinned;    // Pieces of the player that shield their king from an opponent slider
+};
+
+static_assert(is_trivially_copyable<BoardState>::value, "BoardState must be copyable as plain bytes");
+static_assert(sizeof(BoardState) <= 160, "BoardState should stay small enough to copy cheaply");
 
 // ChessGame class representing a chessboard and managing the state of a chess game
 class ChessGame {
 private:
-    // A 2D array to store pointers to chess pieces, representing the board. A nullptr represents an empty square.
-    ChessPiece* board[8][8];
+    // The current position
+    BoardState state;
 
-    // Represents the current player's turn, either WHITE or BLACK
-    Color currentTurn;
+    // Code of the piece on each square (0 is A1), kept in step with the bitboards so that the piece on a square
+    // is found with a single lookup. NO_PIECE represents an empty square.
+    // It can be rebuilt from the bitboards, so it is not part of BoardState.
+    Piece board[SQUARE_NB];
+
+    // Optional table caching the game-end status of positions already evaluated, or nullptr.
+    // The table is owned by the caller and may be shared by several games.
+    TranspositionTable* transpositionTable;
+
+    // Optional observer told about every loaded state and submitted move, or nullptr.
+    // The observer is owned by the caller.
+    GameObserver* observer;
+
+    // Undo records of the moves played since the state was loaded, most recent last.
+    // Its block comes from a per-thread pool, so creating a game does not allocate once the pool is warm,
+    // and making moves does not allocate either.
+    UndoStack history;
+
+    // Hashes of the positions that led to the state loaded by restore, oldest first, for the repetition checks.
+    // They come before the first record of the history; setState and restore without keys leave it empty.
+    vector<uint64_t> earlierKeys;
+
+    // Places a piece on an empty square, updating both the bitboards and the board
+    void putPiece(Piece piece, int square);
+
+    // Takes the piece on a square off the board, updating both the bitboards and the board
+    void removePiece(int square);
+
+    // Moves the piece on 'from' to 'to' and removes any piece standing on 'to', storing its type in 'capturedType'
+    void relocatePiece(int from, int to, PieceType& capturedType);
+
+    // Reverts relocatePiece, putting the moved piece back on 'from' and the removed piece back on 'to'
+    void revertRelocation(int from, int to, PieceType capturedType);
+
+    // Returns the squares the piece on 'square' may move to by its moving rule, castling aside,
+    // without checking whether the move leaves its king in check
+    Bitboard targetsFrom(int square) const;
+
+    // Appends the moves of the given color that follow each piece's moving rule, including castling,
+    // without checking whether they leave the king in check. With 'capturesOnly', only captures are generated.
+    void generatePseudoLegalMoves(Color color, MoveList& moves, bool capturesOnly) const;
+
+    // Appends the four promotions of a pawn move from 'from' to 'to', the queen first
+    static void addPromotions(int from, int to, MoveList& moves);
+
+    // Checks if the given color may castle on the king side or the queen side
+    bool canCastle(Color color, bool isKingSide) const;
+
+    // Checks if the given color still holds the castling right for the king side or the queen side
+    bool hasCastlingRight(Color color, bool isKingSide) const;
+
+    // Works out the checkers, the check mask and the pinned pieces of the given color's king
+    LegalityInfo legalityInfo(Color color) const;
+
+    // Checks if a pseudo-legal move keeps the moving player's king out of check, using the mover's legality info.
+    // Only king moves and en passant captures need to look for attacks on the board.
+    bool isLegal(const ChessMove& move, const LegalityInfo& info) const;
+
+    // Checks if the given color has at least one legal move, stopping at the first one found
+    bool hasLegalMove(Color color, const LegalityInfo& info) const;
+
+    // Returns the pieces of both colors attacking a square, given the set of occupied squares
+    Bitboard attackersTo(int square, Bitboard occupied) const;
+
+    // Computes the Zobrist hash of the current position from scratch
+    uint64_t computeKey() const;
+
+    // Computes the Zobrist hash of the pawns of the current position from scratch
+    uint64_t computePawnKey() const;
 
-    // Flags to track castling availability for each side (kingside or queenside)
-    bool whiteKingSideCastling;
-    bool whiteQueenSideCastling;
-    bool blackKingSideCastling;
-    bool blackQueenSideCastling;
+    // Returns whether the player to move is in check, checkmate, stalemate or none of them, draws aside
+    GameStatus positionStatus() const;
+
+    // Counts how many times the current position occurred in the game with the same player to move, this one included
+    int repetitionCount() const;
+
+    // Returns the hash of the position the given number of plies after the loaded state. Negative plies reach back
+    // into the earlier keys given to restore.
+    uint64_t keyAtPly(int ply) const;
+
+    // Checks if neither side has enough material left to checkmate
+    bool hasInsufficientMaterial() const;
+
+    // Performs the general checks of initialCheck, returning the first one that fails or MOVE_OK
+    MoveOutcome initialOutcome(const Position& from, const Position& to) const;
+
+    // Checks a move that passed the general checks against the moving rules and plays it if it is legal.
+    // The captured piece, the promotion piece and whether the move castles are recorded in 'result'.
+    MoveOutcome moveOutcome(const Position& from, const Position& to, PieceType promotion, MoveResult& result);
+
+    // Performs a castling move from 'from' to 'to' if the game rules allow it, otherwise returns the reason why not
+    MoveOutcome performCastling(const Position& from, const Position& to);
 
 public:
     // Constructor that initializes an empty chessboard
     ChessGame();
-     // Destructor that ensures proper cleanup of all chess pieces
-    ~ChessGame();
+
+    // Copy constructor and assignment giving a game that can be played independently of the original (for example
+    // by a different search thread). The transposition table and the observer, if any, are shared.
+    ChessGame(const ChessGame& other) = default;
+    ChessGame& operator=(const ChessGame& other) = default;
 
     // Loads the board state from a given FEN string, initializing the chessboard accordingly.
+    // The observer, if any, is told whether the string was valid.
     void loadState(const string& fen);
 
+    // Loads the board state from a given FEN string like loadState, but without printing anything.
+    // All six FEN fields are read; the last three may be left out. If the string is invalid, the game is left
+    // unchanged and the returned result tells why.
+    FenResult setState(string_view fen);
+
+    // Returns the position as a FEN string with all six fields
+    string toFEN() const;
+
     // Submits a move from 'fromStr' to 'toStr', which are string representations of the positions.
-    bool submitMove(const string& fromStr, const string& toStr);
+    // A pawn reaching the last rank promotes to 'promotion', which must be a knight, bishop, rook or queen.
+    bool submitMove(const string& fromStr, const string& toStr, PieceType promotion = QUEEN);
+
+    // Checks a move from 'from' to 'to' against the rules and plays it if it is legal. The returned result,
+    // which is also passed to the observer, tells whether the move was played and what followed.
+    // A pawn reaching the last rank promotes to 'promotion', which must be a knight, bishop, rook or queen.
+    MoveResult playMove(const Position& from, const Position& to, PieceType promotion = QUEEN);
+
+    // Attaches an observer told about every loaded state and submitted move, or detaches it with nullptr
+    void setObserver(GameObserver* gameObserver);
+
+    // Plays a legal move (as produced by generateLegalMoves) without any validation or output.
+    // An undo record is pushed so that the move can be taken back with unmakeMove.
+    void makeMove(const ChessMove& move);
+
+    // Takes back the most recent move played by makeMove or submitMove, restoring the exact previous state
+    void unmakeMove();
+
+    // Returns a copy of the current position, which restore can bring back later or into another game
+    BoardState snapshot() const;
+
+    // Sets the position to one taken by snapshot. The moves played before it are forgotten, so unmakeMove cannot
+    // go back past it and repetitions are counted from it. Nothing is reported to the observer.
+    void restore(const BoardState& boardState);
+
+    // Sets the position to one taken by snapshot like restore, but keeps the hashes of the positions that led to it
+    // (oldest first, with the same player to move every second one) so that repetitions of them are detected.
+    // Only the positions since the last capture or pawn move can repeat, so earlier ones may be left out.
+    void restore(const BoardState& boardState, const vector<uint64_t>& keys);
+
+    // Returns the 64-bit Zobrist hash of the position (pieces, side to move, castling flags and en passant file)
+    uint64_t hash() const;
+
+    // Returns the 64-bit Zobrist hash of the pawns of both colors
+    uint64_t getPawnKey() const;
+
+    // Getter for the undo records of the moves played since the state was loaded, most recent last. Record i holds
+    // the move played from the position i plies after the load, and the hash of that position.
+    const UndoStack& getHistory() const;
+
+    // Checks if the current position already occurred earlier in the game with the same player to move
+    bool isRepetition() const;
+
+    // Getter for the player whose turn it is
+    Color getCurrentTurn() const;
+
+    // Getter for the number of halfmoves since the last capture or pawn move
+    int getHalfmoveClock() const;
+
+    // Getters for the material and piece-square score of the position (see Evaluation.h) and its game phase
+    Score getPieceSquareScore() const;
+    int getPhase() const;
+
+    // Returns the static evaluation of the position in centipawns, from the point of view of the player to move
+    int evaluate() const;
+
+    // Getter for the square a pawn may capture en passant on (0 is A1), or NO_SQUARE
+    int getEnPassantSquare() const;
+
+    // Getter for the mask of CastlingRight bits still held
+    uint8_t getCastlingRights() const;
+
+    // Getters for the bitboards of the pieces of one color and type, and of all pieces of one color
+    Bitboard getPieces(Color color, PieceType type) const;
+    Bitboard getOccupancy(Color color) const;
+
+    // Returns the code of the piece standing on a square (0 is A1), or NO_PIECE if the square is empty
+    Piece pieceOn(int square) const;
+
+    // Returns the type of the piece standing on a square (0 is A1), or PIECE_TYPE_NB if the square is empty
+    PieceType pieceTypeOn(int square) const;
+
+    // Attaches a transposition table consulted before the game-end evaluation of each move, or detaches it with nullptr
+    void setTranspositionTable(TranspositionTable* table);
+
+    // Returns whether the player to move is in check, checkmate or stalemate, whether the game is drawn by the
+    // fifty- or seventy-five-move rule, threefold or fivefold repetition or insufficient material, or none of them
+    GameStatus getGameStatus() const;
+
+    // Returns the draw the game has reached, or ONGOING. A draw that ends the game by itself comes before one that
+    // can only be claimed. Checkmate and stalemate are not looked for.
+    GameStatus drawStatus() const;
 
     // Executes the move from 'from' to 'to'. Returns true if the move is successful, false otherwise.
     bool Move(const Position& from, const Position& to);
@@ -49,33 +299,43 @@ public:
     
     // Checks if the king of the given color is in check.
     bool isKingInCheck(Color kingColor) const;
+
+    // Checks if the square (0 is A1, 63 is H8) is attacked by any piece of the given color.
+    bool isSquareAttacked(int square, Color attackerColor) const;
     
     // Checks if the king of the given color is in checkmate.
-    bool isCheckmate(Color kingColor);
+    bool isCheckmate(Color kingColor) const;
     
     //Method to check if it is a stalmate
-    bool isStalemate(Color color);
+    bool isStalemate(Color color) const;
+
+    // Fills 'moves' with every legal move of the player whose turn it is, including castling.
+    void generateLegalMoves(MoveList& moves) const;
+
+    // Fills 'moves' with the legal captures of the player whose turn it is.
+    void generateLegalCaptures(MoveList& moves) const;
+
+    // Counts the leaf nodes of the legal move tree 'depth' plies deep from the current position (perft).
+    // When 'rootCounts' is not nullptr, each root move is appended to it together with the count below it.
+    uint64_t perft(int depth, vector<pair<ChessMove, uint64_t>>* rootCounts = nullptr);
     
     //Method to check if a king will be in check when castling
     bool isKingInCheckAfterMove(const Position& from, const Position& to);
     
-    // Method to print the current state of the chessboard
-    void printBoard() const;
+    // Returns the chessboard as eight lines of text, one per row, with uppercase letters for white pieces, lowercase
+    // letters for black pieces and dots for empty squares
+    string toString() const;
 
     // Helper function to clear the board
     void clearBoard();
 
-    // Helper function to print invalid move messages
-    void printInvalidMoveMessage(const ChessPiece* piece, const Position& to) const;
-
     // Method to check if a position is occupied
     bool isOccupied(const Position& pos) const;
 
-    // Method to get the piece at a given position. Returns a pointer to the piece, or nullptr if no piece is present
-    ChessPiece* getPieceAt(const Position& pos) const;
-
-    // Performs a castling move from 'from' to 'to', if allowed by game rules
-    bool performCastling(const Position& from, const Position& to);
+    // Method to get the piece at a given position. Returns a pointer to the piece, or nullptr if no piece is present.
+    // The board stores piece codes, so the object returned is a shared, stateless ChessPiece of the right color and
+    // type; it is kept for code written against the ChessPiece classes and stays valid for the whole program.
+    const ChessPiece* getPieceAt(const Position& pos) const;
 };
 
 #endif // CHESSGAME_H
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include"ChessGame.h"
+#include"ConsoleObserver.h"
 
 #include<iostream>
 
@@ -11,6 +12,8 @@ int main() {
 	cout << "========================\n\n";
 
 	ChessGame cg;
+	ConsoleObserver console; // Prints what happens in the game
+	cg.setObserver(&console);
 	cg.loadState("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq");
 	cout << '\n';
 
@@ -0,0 +1,15 @@
+// ChessMove.cpp
+#include "ChessMove.h"
+
+// Returns the move in coordinate notation, e.g. "e2e4", with the promotion piece appended for promotions ("e7e8q")
+string ChessMove::toString() const {
+    string text;
+    text += char('a' + fileOf(getFrom()));
+    text += char('1' + rankOf(getFrom()));
+    text += char('a' + fileOf(getTo()));
+    text += char('1' + rankOf(getTo()));
+    if (getType() == PROMOTION) {
+        text += "nbrq"[getPromotion() - KNIGHT];
+    }
+    return text;
+}
@@ -0,0 +1,105 @@
+// ChessMove.h
+// This file defines the ChessMove class, a compact 16-bit encoding of a move, and MoveList,
+// a fixed-capacity list of moves that lives on the stack so that move generation never allocates.
+
+#ifndef CHESSMOVE_H
+#define CHESSMOVE_H
+
+#include "Bitboard.h"
+#include <cstdint>
+#include <string>
+using namespace std;
+
+// Defining MoveType enumeration, which marks the moves that need special handling on the board
+enum MoveType {
+    NORMAL_MOVE,
+    PROMOTION,
+    EN_PASSANT,
+    CASTLING
+};
+
+// ChessMove class packing a move into 16 bits:
+// bits 0-5 hold the source square, bits 6-11 the destination square,
+// bits 12-13 the MoveType and bits 14-15 the promotion piece (KNIGHT to QUEEN, minus KNIGHT).
+class ChessMove {
+private:
+    uint16_t data; // The encoded move, 0 for a null move
+
+public:
+    // Default constructor, creates a null move
+    ChessMove() : data(0) {}
+
+    // Constructor that encodes a move from 'from' to 'to' (square indices, 0 is A1)
+    ChessMove(int from, int to, MoveType type = NORMAL_MOVE, PieceType promotion = KNIGHT)
+        : data(uint16_t(from | (to << 6) | (type << 12) | ((promotion - KNIGHT) << 14))) {}
+
+    // Getter for the source square
+    int getFrom() const { return data & 0x3F; }
+
+    // Getter for the destination square
+    int getTo() const { return (data >> 6) & 0x3F; }
+
+    // Getter for the kind of move (normal, promotion, en passant or castling)
+    MoveType getType() const { return MoveType((data >> 12) & 3); }
+
+    // Getter for the piece a pawn promotes to; only meaningful for PROMOTION moves
+    PieceType getPromotion() const { return PieceType(((data >> 14) & 3) + KNIGHT); }
+
+    // Checks if this is the null move
+    bool isNull() const { return data == 0; }
+
+    // Getter for the raw 16-bit encoding, used to store moves compactly
+    uint16_t getData() const { return data; }
+
+    // Rebuilds a move from its raw 16-bit encoding
+    static ChessMove fromData(uint16_t raw) {
+        ChessMove move;
+        move.data = raw;
+        return move;
+    }
+
+    // Overloads the equality operator to compare two moves
+    bool operator==(const ChessMove& other) const { return data == other.data; }
+
+    // Overloads the inequality operator to compare two moves
+    bool operator!=(const ChessMove& other) const { return data != other.data; }
+
+    // Returns the move in coordinate notation (e.g., "e2e4", or "e7e8q" for a promotion)
+    string toString() const;
+};
+
+// Maximum number of moves a chess position can have (the known maximum is 218)
+const int MAX_MOVES = 256;
+
+// MoveList class holding the moves of one position in a fixed-size array
+class MoveList {
+private:
+    ChessMove moves[MAX_MOVES]; // Storage for the moves
+    int count;                  // Number of moves currently stored
+
+public:
+    // Constructor that creates an empty list
+    MoveList() : count(0) {}
+
+    // Appends a move to the list
+    void add(const ChessMove& move) { moves[count++] = move; }
+
+    // Removes all moves from the list
+    void clear() { count = 0; }
+
+    // Returns the number of moves in the list
+    int size() const { return count; }
+
+    // Checks if the list holds no moves
+    bool empty() const { return count == 0; }
+
+    // Returns the move at the given index
+    const ChessMove& operator[](int index) const { return moves[index]; }
+    ChessMove& operator[](int index) { return moves[index]; }
+
+    // Iterators so the list can be used in range-based for loops
+    const ChessMove* begin() const { return moves; }
+    const ChessMove* end() const { return moves + count; }
+};
+
+#endif // CHESSMOVE_H
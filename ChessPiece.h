@@ -1,6 +1,8 @@
 // ChessPiece.h
 // ChessPiece is an abstract base class, which serves as a blueprint for all chess pieces.
 // It provides a common interface for setting the piece color, getting the piece symbol, and validating moves.
+// The board itself stores one-byte Piece codes and checks moves with the attack tables; ChessGame::getPieceAt hands
+// out one shared ChessPiece object per color and type for code that works with the classes.
 
 #ifndef CHESSPIECE_H
 #define CHESSPIECE_H
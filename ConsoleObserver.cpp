@@ -0,0 +1,92 @@
+// ConsoleObserver.cpp
+#include "ConsoleObserver.h"
+
+// Names of the piece types, indexed by PieceType
+static const char* const PieceNames[PIECE_TYPE_NB] = {"Pawn", "Knight", "Bishop", "Rook", "Queen", "King"};
+
+// Helper function to name a color as an owner, e.g. "White's"
+static const char* owner(Color color) {
+    return (color == WHITE) ? "White's" : "Black's";
+}
+
+// Constructor that prints to the given stream
+ConsoleObserver::ConsoleObserver(ostream& stream) : out(stream) {
+}
+
+// Method to print whether the state was loaded
+void ConsoleObserver::onStateLoaded(const FenResult& result) {
+    if (result.ok()) {
+        out << "A new board state is loaded!" << '\n';
+    } else {
+        out << fenErrorMessage(result.error) << '\n';
+    }
+}
+
+// Method to print the move played, or why it was refused
+void ConsoleObserver::onMove(const MoveResult& result) {
+    switch (result.outcome) {
+        case MOVE_OK:
+            break;
+        case MOVE_NO_PIECE:
+            out << "There is no piece at position " << result.from << "!" << '\n';
+            return;
+        case MOVE_WRONG_TURN:
+            out << "It is not " << owner(result.color) << " turn to move!" << '\n';
+            return;
+        case MOVE_ILLEGAL:
+            out << owner(result.color) << ' ' << PieceNames[result.piece] << " cannot move to " << result.to << "!" << '\n';
+            return;
+        case MOVE_OWN_KING_IN_CHECK:
+            out << "Move puts your own king in check." << '\n';
+            return;
+        case CASTLING_KING_MOVED:
+            out << "Invalid castling move: king condition not met." << '\n' << "Not valid castling" << '\n';
+            return;
+        case CASTLING_ROOK_MOVED:
+            out << "Invalid castling move: rook condition not met." << '\n' << "Not valid castling" << '\n';
+            return;
+        case CASTLING_RIGHT_LOST:
+            out << "Invalid castling move: castling right has been lost." << '\n' << "Not valid castling" << '\n';
+            return;
+        case CASTLING_IN_CHECK:
+            out << "Cannot castle while in check." << '\n' << "Not valid castling" << '\n';
+            return;
+        case CASTLING_PATH_BLOCKED:
+            out << "Invalid castling move: path not clear or king passes through threatened square." << '\n'
+                << "Not valid castling" << '\n';
+            return;
+    }
+
+    // The move was played: describe it, then the situation it leaves the opponent in
+    if (result.castling) {
+        out << "Castling move performed" << '\n';
+    } else {
+        out << owner(result.color) << ' ' << PieceNames[result.piece] << " moves from " << result.from << " to " << result.to;
+        if (result.captured != PIECE_TYPE_NB) {
+            out << " taking " << owner(result.color == WHITE ? BLACK : WHITE) << ' ' << PieceNames[result.captured];
+        }
+        if (result.promotion != PIECE_TYPE_NB) {
+            out << " and promotes to " << PieceNames[result.promotion];
+        }
+        out << '\n';
+    }
+
+    const char* opponent = (result.color == WHITE) ? "Black" : "White";
+    if (result.status == CHECKMATE) {
+        out << opponent << " is in checkmate" << '\n';
+    } else if (result.status == CHECK) {
+        out << opponent << " is in check" << '\n';
+    } else if (result.status == STALEMATE) {
+        out << opponent << " is in stalemate" << '\n';
+    } else if (result.status == FIFTY_MOVE_DRAW) {
+        out << "The game is drawn by the fifty-move rule" << '\n';
+    } else if (result.status == SEVENTY_FIVE_MOVE_DRAW) {
+        out << "The game is drawn by the seventy-five-move rule" << '\n';
+    } else if (result.status == THREEFOLD_REPETITION) {
+        out << "The game is drawn by threefold repetition" << '\n';
+    } else if (result.status == FIVEFOLD_REPETITION) {
+        out << "The game is drawn by fivefold repetition" << '\n';
+    } else if (result.status == INSUFFICIENT_MATERIAL) {
+        out << "The game is drawn: neither side can checkmate" << '\n';
+    }
+}
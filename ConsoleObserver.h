@@ -0,0 +1,29 @@
+// ConsoleObserver.h
+// The ConsoleObserver class implements GameObserver by printing a human-readable message for every event,
+// such as "White's Pawn moves from E2 to E4" or "Black is in check".
+
+#ifndef CONSOLEOBSERVER_H
+#define CONSOLEOBSERVER_H
+
+#include "GameObserver.h"
+#include <iostream>
+
+using namespace std;
+
+// ConsoleObserver class printing the events of a game to an output stream
+class ConsoleObserver : public GameObserver {
+private:
+    ostream& out; // Stream the messages are written to
+
+public:
+    // Constructor that prints to the given stream, the standard output by default
+    ConsoleObserver(ostream& stream = cout);
+
+    // Prints whether the state was loaded, or why it was not
+    void onStateLoaded(const FenResult& result) override;
+
+    // Prints the move played and the opponent's situation, or why the move was refused
+    void onMove(const MoveResult& result) override;
+};
+
+#endif // CONSOLEOBSERVER_H
@@ -0,0 +1,289 @@
+// Evaluation.cpp
+// This file fills the evaluation tables declared in Evaluation.h and computes the terms that are not kept
+// incrementally. The piece-square tables below are written as seen from White's side, rank 8 first, so that they
+// read like a board diagram; a White piece on 'square' uses entry square ^ 56 and a Black piece uses entry 'square'.
+
+#include "Evaluation.h"
+#include "ChessGame.h"
+#include "Attacks.h"
+#include "PawnTable.h"
+#include <algorithm>
+
+Score PieceSquareScores[NO_PIECE][SQUARE_NB];
+int PiecePhase[NO_PIECE];
+
+// Material value of each piece type in the middlegame and in the endgame, indexed by PieceType
+static const int MiddlegameMaterial[PIECE_TYPE_NB] = {100, 320, 330, 500, 900, 0};
+static const int EndgameMaterial[PIECE_TYPE_NB] = {120, 290, 310, 530, 940, 0};
+
+// Contribution of each piece type to the game phase, indexed by PieceType
+static const int PhaseWeights[PIECE_TYPE_NB] = {0, 1, 1, 2, 4, 0};
+
+// Piece-square values in the middlegame, indexed by PieceType and then by square as seen by White, rank 8 first
+static const int MiddlegameTables[PIECE_TYPE_NB][SQUARE_NB] = {
+    { // Pawn
+          0,   0,   0,   0,   0,   0,   0,   0,
+         50,  50,  50,  50,  50,  50,  50,  50,
+         10,  10,  20,  30,  30,  20,  10,  10,
+          5,   5,  10,  25,  25,  10,   5,   5,
+          0,   0,   0,  20,  20,   0,   0,   0,
+          5,  -5, -10,   0,   0, -10,  -5,   5,
+          5,  10,  10, -20, -20,  10,  10,   5,
+          0,   0,   0,   0,   0,   0,   0,   0 },
+    { // Knight
+        -50, -40, -30, -30, -30, -30, -40, -50,
+        -40, -20,   0,   0,   0,   0, -20, -40,
+        -30,   0,  10,  15,  15,  10,   0, -30,
+        -30,   5,  15,  20,  20,  15,   5, -30,
+        -30,   0,  15,  20,  20,  15,   0, -30,
+        -30,   5,  10,  15,  15,  10,   5, -30,
+        -40, -20,   0,   5,   5,   0, -20, -40,
+        -50, -40, -30, -30, -30, -30, -40, -50 },
+    { // Bishop
+        -20, -10, -10, -10, -10, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,  10,  10,   5,   0, -10,
+        -10,   5,   5,  10,  10,   5,   5, -10,
+        -10,   0,  10,  10,  10,  10,   0, -10,
+        -10,  10,  10,  10,  10,  10,  10, -10,
+        -10,   5,   0,   0,   0,   0,   5, -10,
+        -20, -10, -10, -10, -10, -10, -10, -20 },
+    { // Rook
+          0,   0,   0,   0,   0,   0,   0,   0,
+          5,  10,  10,  10,  10,  10,  10,   5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+          0,   0,   0,   5,   5,   0,   0,   0 },
+    { // Queen
+        -20, -10, -10,  -5,  -5, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,   5,   5,   5,   0, -10,
+         -5,   0,   5,   5,   5,   5,   0,  -5,
+          0,   0,   5,   5,   5,   5,   0,  -5,
+        -10,   5,   5,   5,   5,   5,   0, -10,
+        -10,   0,   5,   0,   0,   0,   0, -10,
+        -20, -10, -10,  -5,  -5, -10, -10, -20 },
+    { // King
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -20, -30, -30, -40, -40, -30, -30, -20,
+        -10, -20, -20, -20, -20, -20, -20, -10,
+         20,  20,   0,   0,   0,   0,  20,  20,
+         20,  30,  10,   0,   0,  10,  30,  20 },
+};
+
+// Piece-square values in the endgame for the pieces whose best squares change: pawns gain from advancing and the
+// king from heading for the centre. The other pieces use their middlegame table.
+static const int EndgamePawnTable[SQUARE_NB] = {
+      0,   0,   0,   0,   0,   0,   0,   0,
+     80,  80,  80,  80,  80,  80,  80,  80,
+     50,  50,  50,  50,  50,  50,  50,  50,
+     30,  30,  30,  30,  30,  30,  30,  30,
+     15,  15,  15,  15,  15,  15,  15,  15,
+      5,   5,   5,   5,   5,   5,   5,   5,
+      0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0 };
+static const int EndgameKingTable[SQUARE_NB] = {
+    -50, -40, -30, -20, -20, -30, -40, -50,
+    -30, -20, -10,   0,   0, -10, -20, -30,
+    -30, -10,  20,  30,  30,  20, -10, -30,
+    -30, -10,  30,  40,  40,  30, -10, -30,
+    -30, -10,  30,  40,  40,  30, -10, -30,
+    -30, -10,  20,  30,  30,  20, -10, -30,
+    -30, -30,   0,   0,   0,   0, -30, -30,
+    -50, -30, -30, -30, -30, -30, -30, -50 };
+
+// Pawn structure terms
+static const Score DoubledPawn = makeScore(-10, -20);
+static const Score IsolatedPawn = makeScore(-12, -15);
+static const Score BackwardPawn = makeScore(-8, -10);
+static const Score PassedPawn[8] = {  // Indexed by the rank of the pawn counted from its own side
+    makeScore(0, 0), makeScore(5, 10), makeScore(10, 20), makeScore(15, 35),
+    makeScore(25, 60), makeScore(40, 100), makeScore(60, 150), makeScore(0, 0) };
+
+// Bonus of a passed pawn whose next square is empty, by the rank of the pawn counted from its own side
+static const Score FreePassedPawn[8] = {
+    makeScore(0, 0), makeScore(0, 5), makeScore(0, 10), makeScore(5, 20),
+    makeScore(10, 35), makeScore(15, 55), makeScore(20, 80), makeScore(0, 0) };
+
+// Mobility terms: the value of each square a piece can go to, and the number of squares of an average piece,
+// which scores zero. Indexed by PieceType.
+static const Score MobilityWeight[PIECE_TYPE_NB] = {
+    makeScore(0, 0), makeScore(4, 4), makeScore(5, 5), makeScore(2, 4), makeScore(1, 2), makeScore(0, 0) };
+static const int AverageMobility[PIECE_TYPE_NB] = {0, 4, 6, 7, 13, 0};
+
+// King safety terms: the bonus of each pawn sheltering the king, and the weight of each attack on the squares
+// around it by piece type. The attack weights add up to a danger count whose square is the penalty.
+static const Score PawnShelter = makeScore(12, 0);
+static const int KingAttackWeight[PIECE_TYPE_NB] = {0, 2, 2, 3, 5, 0};
+static const int MAX_KING_DANGER = 500;
+
+// Squares in front of a pawn on its own and the adjacent files, which must hold no enemy pawn for it to be passed.
+// Indexed by color and square.
+static Bitboard PassedPawnMask[2][SQUARE_NB];
+
+// Squares on the adjacent files, on the rank of a pawn and behind it, where a pawn of its own color could support
+// its advance. Indexed by color and square.
+static Bitboard PawnSupportMask[2][SQUARE_NB];
+
+// Files next to each file
+static Bitboard AdjacentFiles[8];
+
+// Helper function returning the bitboard of one file
+static Bitboard fileBB(int file) {
+    return FILE_A_BB << file;
+}
+
+// Helper function returning the squares attacked by all the pawns of one color
+static Bitboard pawnAttackSpan(Color color, Bitboard pawns) {
+    if (color == WHITE) {
+        return ((pawns << 7) & ~FILE_H_BB) | ((pawns << 9) & ~FILE_A_BB);
+    }
+    return ((pawns >> 9) & ~FILE_H_BB) | ((pawns >> 7) & ~FILE_A_BB);
+}
+
+// Method to initialize the evaluation tables exactly once
+void initEvaluation() {
+    static bool initialized = []() {
+        for (int type = PAWN; type < PIECE_TYPE_NB; ++type) {
+            const int* endgameTable = (type == PAWN) ? EndgamePawnTable
+                                    : (type == KING) ? EndgameKingTable : MiddlegameTables[type];
+            for (int square = 0; square < SQUARE_NB; ++square) {
+                int whiteEntry = square ^ 56;
+                PieceSquareScores[makePiece(WHITE, PieceType(type))][square] =
+                    makeScore(MiddlegameMaterial[type] + MiddlegameTables[type][whiteEntry],
+                              EndgameMaterial[type] + endgameTable[whiteEntry]);
+                PieceSquareScores[makePiece(BLACK, PieceType(type))][square] =
+                    -makeScore(MiddlegameMaterial[type] + MiddlegameTables[type][square],
+                               EndgameMaterial[type] + endgameTable[square]);
+            }
+            PiecePhase[makePiece(WHITE, PieceType(type))] = PhaseWeights[type];
+            PiecePhase[makePiece(BLACK, PieceType(type))] = PhaseWeights[type];
+        }
+
+        for (int file = 0; file < 8; ++file) {
+            AdjacentFiles[file] = ((file > 0) ? fileBB(file - 1) : 0) | ((file < 7) ? fileBB(file + 1) : 0);
+        }
+        for (int square = 0; square < SQUARE_NB; ++square) {
+            Bitboard files = fileBB(fileOf(square)) | AdjacentFiles[fileOf(square)];
+            int rank = rankOf(square);
+            PassedPawnMask[WHITE][square] = (rank < 7) ? files & (~Bitboard(0) << (8 * (rank + 1))) : 0;
+            PassedPawnMask[BLACK][square] = (rank > 0) ? files & (~Bitboard(0) >> (8 * (8 - rank))) : 0;
+            PawnSupportMask[WHITE][square] = AdjacentFiles[fileOf(square)] & ~PassedPawnMask[WHITE][square];
+            PawnSupportMask[BLACK][square] = AdjacentFiles[fileOf(square)] & ~PassedPawnMask[BLACK][square];
+        }
+        return true;
+    }();
+    (void)initialized;
+}
+
+// Helper function to score the pawn structure of one color, from that color's point of view, adding its passed
+// pawns to 'passedPawns'.
+// A pawn is backward when no pawn of its own can come up beside it and an enemy pawn guards the square in front of it.
+static Score pawnStructure(Color color, Bitboard pawns, Bitboard enemyPawns, Bitboard& passedPawns) {
+    Score score = 0;
+    for (int file = 0; file < 8; ++file) {
+        int count = popCount(pawns & fileBB(file));
+        if (count > 1) {
+            score += DoubledPawn * (count - 1);
+        }
+    }
+
+    Bitboard remaining = pawns;
+    while (remaining) {
+        int square = popLsb(remaining);
+        if (!(pawns & AdjacentFiles[fileOf(square)])) {
+            score += IsolatedPawn;
+        } else if (!(pawns & PawnSupportMask[color][square])) {
+            int stop = square + ((color == WHITE) ? 8 : -8);
+            if (stop >= 0 && stop < SQUARE_NB && (pawnAttacks(color, stop) & enemyPawns)) {
+                score += BackwardPawn;
+            }
+        }
+        if (!(enemyPawns & PassedPawnMask[color][square])) {
+            score += PassedPawn[(color == WHITE) ? rankOf(square) : 7 - rankOf(square)];
+            passedPawns |= squareBB(square);
+        }
+    }
+    return score;
+}
+
+// Method to score the pawn structure of both colors, from White's point of view
+Score evaluatePawns(Bitboard whitePawns, Bitboard blackPawns, Bitboard& passedPawns) {
+    passedPawns = 0;
+    return pawnStructure(WHITE, whitePawns, blackPawns, passedPawns)
+         - pawnStructure(BLACK, blackPawns, whitePawns, passedPawns);
+}
+
+// Helper function to score the passed pawns of one color whose way forward is open, from that color's point of view.
+// Whether the next square is free depends on the other pieces, so this part cannot be cached with the pawns.
+static Score freePassedPawns(const ChessGame& game, Color color, Bitboard passedPawns) {
+    Bitboard occupied = game.getOccupancy(WHITE) | game.getOccupancy(BLACK);
+    Bitboard pawns = passedPawns & game.getPieces(color, PAWN);
+    Bitboard free = (color == WHITE) ? pawns & ~(occupied >> 8) : pawns & ~(occupied << 8);
+    Score score = 0;
+    while (free) {
+        int square = popLsb(free);
+        score += FreePassedPawn[(color == WHITE) ? rankOf(square) : 7 - rankOf(square)];
+    }
+    return score;
+}
+
+// Helper function to score the mobility and the attacks on the enemy king of one color's pieces, and the pawn
+// shelter of its own king, from that color's point of view.
+// A piece's mobility counts the squares it attacks that hold no piece of its own and are not attacked by an
+// enemy pawn, since moving there would lose it for a pawn.
+static Score piecesAndKing(const ChessGame& game, Color color) {
+    Color enemy = (color == WHITE) ? BLACK : WHITE;
+    Bitboard occupied = game.getOccupancy(WHITE) | game.getOccupancy(BLACK);
+    Bitboard safe = ~game.getOccupancy(color) & ~pawnAttackSpan(enemy, game.getPieces(enemy, PAWN));
+    Bitboard enemyKing = game.getPieces(enemy, KING);
+    Bitboard enemyKingZone = enemyKing ? (kingAttacks(lsb(enemyKing)) | enemyKing) : 0;
+
+    Score score = 0;
+    int danger = 0;
+    for (int type = KNIGHT; type <= QUEEN; ++type) {
+        Bitboard pieces = game.getPieces(color, PieceType(type));
+        while (pieces) {
+            Bitboard attacks = attacksOf(PieceType(type), popLsb(pieces), occupied);
+            score += MobilityWeight[type] * (popCount(attacks & safe) - AverageMobility[type]);
+            danger += KingAttackWeight[type] * popCount(attacks & enemyKingZone);
+        }
+    }
+    score += makeScore(min(MAX_KING_DANGER, danger * danger / 2), danger);
+
+    // Pawns on the king's file and the files next to it, one or two ranks in front of the king
+    Bitboard king = game.getPieces(color, KING);
+    if (king) {
+        int kingSquare = lsb(king);
+        Bitboard files = fileBB(fileOf(kingSquare)) | AdjacentFiles[fileOf(kingSquare)];
+        Bitboard ranks = 0;
+        for (int step = 1; step <= 2; ++step) {
+            int shelterRank = (color == WHITE) ? rankOf(kingSquare) + step : rankOf(kingSquare) - step;
+            if (shelterRank >= 0 && shelterRank < 8) {
+                ranks |= RANK_1_BB << (8 * shelterRank);
+            }
+        }
+        score += PawnShelter * popCount(game.getPieces(color, PAWN) & files & ranks);
+    }
+    return score;
+}
+
+// Method to evaluate a position: the incrementally kept material and piece-square sum, plus the pawn structure,
+// mobility and king safety terms, blended by the game phase
+int evaluate(const ChessGame& game) {
+    const PawnEntry& pawns = PawnTable::forThread().probe(game.getPawnKey(), game.getPieces(WHITE, PAWN),
+                                                          game.getPieces(BLACK, PAWN));
+    Score score = game.getPieceSquareScore() + pawns.score
+                + freePassedPawns(game, WHITE, pawns.passedPawns) - freePassedPawns(game, BLACK, pawns.passedPawns)
+                + piecesAndKing(game, WHITE) - piecesAndKing(game, BLACK);
+
+    int phase = min(game.getPhase(), MAX_PHASE);
+    int value = (middlegameValue(score) * phase + endgameValue(score) * (MAX_PHASE - phase)) / MAX_PHASE;
+    return (game.getCurrentTurn() == WHITE) ? value : -value;
+}
@@ -0,0 +1,61 @@
+// Evaluation.h
+// This file declares the static evaluation of a position, in centipawns from the point of view of the player to move.
+// Every term has a middlegame and an endgame value, packed together in a Score, and the two are blended by the game
+// phase, which goes from 24 with all the pieces on the board down to 0 with only kings and pawns left.
+// Material and piece-square values only depend on where each piece stands, so ChessGame keeps their sum and the
+// phase up to date as pieces are put on and taken off squares. The other terms (pawn structure, mobility and king
+// safety) depend on how the pieces interact and are computed from the bitboards when the position is evaluated,
+// except for the pawn structure, which is looked up in the calling thread's PawnTable.
+
+#ifndef EVALUATION_H
+#define EVALUATION_H
+
+#include "Bitboard.h"
+#include "Piece.h"
+#include <cstdint>
+
+using namespace std;
+
+class ChessGame;
+
+// A middlegame and an endgame value packed into one integer, so that both are added and subtracted at once.
+// The endgame value sits in the upper 16 bits and the middlegame value in the lower 16 bits.
+typedef int32_t Score;
+
+// Packs a middlegame and an endgame value into a Score
+inline Score makeScore(int middlegame, int endgame) {
+    return Score(uint32_t(endgame) << 16) + middlegame;
+}
+
+// Unpacks the middlegame value of a Score
+inline int middlegameValue(Score score) {
+    return int16_t(uint16_t(uint32_t(score)));
+}
+
+// Unpacks the endgame value of a Score, rounding for the borrow the middlegame value may have taken from it
+inline int endgameValue(Score score) {
+    return int16_t(uint16_t((uint32_t(score) + 0x8000) >> 16));
+}
+
+// Game phase with every piece on the board
+const int MAX_PHASE = 24;
+
+// Material plus piece-square value of each piece on each square, positive for White and negative for Black.
+// Indexed by Piece and square (0 is A1).
+extern Score PieceSquareScores[NO_PIECE][SQUARE_NB];
+
+// Contribution of each piece to the game phase, indexed by Piece
+extern int PiecePhase[NO_PIECE];
+
+// Fills the evaluation tables. It is safe to call more than once; only the first call does the work.
+void initEvaluation();
+
+// Returns the pawn structure terms (doubled, isolated, backward and passed pawns) from White's point of view,
+// and stores the passed pawns of both colors in 'passedPawns'. The result only depends on the pawns, so the
+// evaluation caches it in a PawnTable.
+Score evaluatePawns(Bitboard whitePawns, Bitboard blackPawns, Bitboard& passedPawns);
+
+// Returns the static score of the game's position from the point of view of the player to move
+int evaluate(const ChessGame& game);
+
+#endif // EVALUATION_H
@@ -0,0 +1,13 @@
+// Evaluator.cpp
+#include "Evaluator.h"
+#include "ChessGame.h"
+
+// Method to score a position with the static evaluation
+int HandcraftedEvaluator::evaluate(const ChessGame& game) {
+    return game.evaluate();
+}
+
+// Getter for the name of the evaluator
+const char* HandcraftedEvaluator::getName() const {
+    return "handcrafted";
+}
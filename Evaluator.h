@@ -0,0 +1,36 @@
+// Evaluator.h
+// This file defines Evaluator, the interface the search scores its leaf positions through, and HandcraftedEvaluator,
+// which scores them with the static evaluation of Evaluation.h. Other evaluators, such as the neural network of
+// Nnue.h, implement the same interface so that the search and the benchmarks can use either one.
+// An evaluator may keep state from one call to the next, so each thread evaluates with an evaluator of its own.
+
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+class ChessGame;
+
+// Evaluator class, the interface of every way of scoring a position
+class Evaluator {
+public:
+    // Virtual destructor so that evaluators can be deleted through the interface
+    virtual ~Evaluator() = default;
+
+    // Returns the score of the game's position in centipawns, from the point of view of the player to move
+    virtual int evaluate(const ChessGame& game) = 0;
+
+    // Returns a short name of the evaluator, for printing
+    virtual const char* getName() const = 0;
+};
+
+// HandcraftedEvaluator class scoring positions with the material, piece-square, pawn structure, mobility and king
+// safety terms of Evaluation.h. It keeps no state of its own.
+class HandcraftedEvaluator : public Evaluator {
+public:
+    // Returns the static evaluation of the game's position
+    int evaluate(const ChessGame& game) override;
+
+    // Returns "handcrafted"
+    const char* getName() const override;
+};
+
+#endif // EVALUATOR_H
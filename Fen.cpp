@@ -0,0 +1,199 @@
+// Fen.cpp
+#include "Fen.h"
+#include "Attacks.h"
+
+// Helper function to skip the spaces between fields. Returns true if another field follows.
+static bool skipSpaces(string_view fen, size_t& i) {
+    while (i < fen.size() && (fen[i] == ' ' || fen[i] == '\t')) {
+        ++i;
+    }
+    return i < fen.size();
+}
+
+// Helper function to read a decimal number of at most six digits. Returns false if there is none.
+static bool readNumber(string_view fen, size_t& i, int& value) {
+    size_t start = i;
+    value = 0;
+    while (i < fen.size() && fen[i] >= '0' && fen[i] <= '9' && i - start < 6) {
+        value = value * 10 + (fen[i] - '0');
+        ++i;
+    }
+    return i > start && (i == fen.size() || fen[i] == ' ' || fen[i] == '\t');
+}
+
+// Helper function to check if the king of 'color' is attacked by the pieces of the other color.
+// 'pieces' holds the squares of each pieceIndex, and each side has exactly one king.
+static bool isInCheck(const Bitboard pieces[], Color color) {
+    initAttacks();
+    Color enemy = (color == WHITE) ? BLACK : WHITE;
+    Bitboard occupied = 0;
+    for (int index = 0; index < 2 * PIECE_TYPE_NB; ++index) {
+        occupied |= pieces[index];
+    }
+    int king = lsb(pieces[pieceIndex(color, KING)]);
+    Bitboard queens = pieces[pieceIndex(enemy, QUEEN)];
+    return (pawnAttacks(color, king) & pieces[pieceIndex(enemy, PAWN)])
+        || (knightAttacks(king) & pieces[pieceIndex(enemy, KNIGHT)])
+        || (kingAttacks(king) & pieces[pieceIndex(enemy, KING)])
+        || (bishopAttacks(king, occupied) & (pieces[pieceIndex(enemy, BISHOP)] | queens))
+        || (rookAttacks(king, occupied) & (pieces[pieceIndex(enemy, ROOK)] | queens));
+}
+
+// Function to parse a FEN string field by field
+FenResult parseFen(string_view fen, FenPosition& position) {
+    FenResult result;
+    size_t i = 0;
+    auto fail = [&](FenError error) {
+        result.error = error;
+        result.offset = i;
+        return result;
+    };
+
+    // Piece placement, from rank 8 down to rank 1 and from file a to file h within each rank
+    if (!skipSpaces(fen, i)) {
+        return fail(FEN_MISSING_FIELD);
+    }
+    for (int square = 0; square < SQUARE_NB; ++square) {
+        position.board[square] = -1;
+    }
+    Bitboard pieces[2 * PIECE_TYPE_NB] = {}; // Squares of each pieceIndex, for the king and check tests
+    int rank = 7;
+    int file = 0;
+    for (; i < fen.size() && fen[i] != ' ' && fen[i] != '\t'; ++i) {
+        char c = fen[i];
+        if (c == '/') {
+            if (file != 8 || rank == 0) {
+                return fail(FEN_BAD_PLACEMENT);
+            }
+            --rank;
+            file = 0;
+        } else if (c >= '1' && c <= '8') {
+            file += c - '0';
+            if (file > 8) {
+                return fail(FEN_BAD_PLACEMENT);
+            }
+        } else {
+            int type;
+            switch (c | 0x20) { // Lowercase
+                case 'p': type = PAWN; break;
+                case 'n': type = KNIGHT; break;
+                case 'b': type = BISHOP; break;
+                case 'r': type = ROOK; break;
+                case 'q': type = QUEEN; break;
+                case 'k': type = KING; break;
+                default: return fail(FEN_BAD_PLACEMENT);
+            }
+            if (file >= 8) {
+                return fail(FEN_BAD_PLACEMENT);
+            }
+            if (type == PAWN && (rank == 0 || rank == 7)) {
+                return fail(FEN_BAD_PAWN);
+            }
+            Color color = (c >= 'a') ? BLACK : WHITE;
+            position.board[rank * 8 + file] = pieceIndex(color, PieceType(type));
+            pieces[pieceIndex(color, PieceType(type))] |= squareBB(rank * 8 + file);
+            ++file;
+        }
+    }
+    if (rank != 0 || file != 8) {
+        return fail(FEN_BAD_PLACEMENT);
+    }
+    if (popCount(pieces[pieceIndex(WHITE, KING)]) != 1 || popCount(pieces[pieceIndex(BLACK, KING)]) != 1) {
+        return fail(FEN_BAD_KINGS);
+    }
+
+    // Side to move
+    if (!skipSpaces(fen, i)) {
+        return fail(FEN_MISSING_FIELD);
+    }
+    if ((fen[i] != 'w' && fen[i] != 'b') || (i + 1 < fen.size() && fen[i + 1] != ' ' && fen[i + 1] != '\t')) {
+        return fail(FEN_BAD_SIDE);
+    }
+    position.sideToMove = (fen[i] == 'w') ? WHITE : BLACK;
+    if (isInCheck(pieces, position.sideToMove == WHITE ? BLACK : WHITE)) {
+        return fail(FEN_OTHER_IN_CHECK);
+    }
+    ++i;
+
+    // Castling rights
+    if (!skipSpaces(fen, i)) {
+        return fail(FEN_MISSING_FIELD);
+    }
+    position.castlingRights = NO_CASTLING;
+    if (fen[i] == '-') {
+        ++i;
+    } else {
+        for (; i < fen.size() && fen[i] != ' ' && fen[i] != '\t'; ++i) {
+            switch (fen[i]) {
+                case 'K': position.castlingRights |= WHITE_KING_SIDE; break;
+                case 'Q': position.castlingRights |= WHITE_QUEEN_SIDE; break;
+                case 'k': position.castlingRights |= BLACK_KING_SIDE; break;
+                case 'q': position.castlingRights |= BLACK_QUEEN_SIDE; break;
+                default: return fail(FEN_BAD_CASTLING);
+            }
+        }
+    }
+    if (i < fen.size() && fen[i] != ' ' && fen[i] != '\t') {
+        return fail(FEN_BAD_CASTLING);
+    }
+
+    // Optional fields, with their defaults
+    position.enPassantSquare = -1;
+    position.halfmoveClock = 0;
+    position.fullmoveNumber = 1;
+
+    // En passant square: behind a pawn of the player who just moved
+    if (!skipSpaces(fen, i)) {
+        return result;
+    }
+    if (fen[i] == '-') {
+        ++i;
+    } else {
+        char expectedRank = (position.sideToMove == WHITE) ? '6' : '3';
+        if (i + 1 >= fen.size() || fen[i] < 'a' || fen[i] > 'h' || fen[i + 1] != expectedRank) {
+            return fail(FEN_BAD_EN_PASSANT);
+        }
+        position.enPassantSquare = (fen[i + 1] - '1') * 8 + (fen[i] - 'a');
+        i += 2;
+    }
+    if (i < fen.size() && fen[i] != ' ' && fen[i] != '\t') {
+        return fail(FEN_BAD_EN_PASSANT);
+    }
+
+    // Halfmove clock and fullmove number
+    if (!skipSpaces(fen, i)) {
+        return result;
+    }
+    if (!readNumber(fen, i, position.halfmoveClock)) {
+        return fail(FEN_BAD_HALFMOVE);
+    }
+    if (!skipSpaces(fen, i)) {
+        return result;
+    }
+    if (!readNumber(fen, i, position.fullmoveNumber) || position.fullmoveNumber == 0) {
+        return fail(FEN_BAD_FULLMOVE);
+    }
+    if (skipSpaces(fen, i)) {
+        return fail(FEN_TRAILING_TEXT);
+    }
+    return result;
+}
+
+// Function to describe a FenError
+const char* fenErrorMessage(FenError error) {
+    switch (error) {
+        case FEN_OK: return "Valid FEN string.";
+        case FEN_MISSING_FIELD: return "Invalid FEN string format.";
+        case FEN_BAD_PLACEMENT: return "Invalid piece placement in FEN string.";
+        case FEN_BAD_KINGS: return "Each side must have exactly one king in FEN string.";
+        case FEN_BAD_PAWN: return "Pawn on the first or eighth rank in FEN string.";
+        case FEN_BAD_SIDE: return "Invalid active color in FEN string.";
+        case FEN_OTHER_IN_CHECK: return "The player not to move is in check in FEN string.";
+        case FEN_BAD_CASTLING: return "Invalid castling availability in FEN string.";
+        case FEN_BAD_EN_PASSANT: return "Invalid en passant square in FEN string.";
+        case FEN_BAD_HALFMOVE: return "Invalid halfmove clock in FEN string.";
+        case FEN_BAD_FULLMOVE: return "Invalid fullmove number in FEN string.";
+        case FEN_TRAILING_TEXT: return "Unexpected text after the FEN string.";
+    }
+    return "Invalid FEN string.";
+}
@@ -0,0 +1,61 @@
+// Fen.h
+// This file declares the FEN (Forsyth-Edwards Notation) parser. parseFen reads the six fields of a FEN string
+// (piece placement, side to move, castling rights, en passant square, halfmove clock and fullmove number) into
+// a FenPosition in one pass over the characters, without allocating and without any output. The last three fields
+// may be left out, as in older FEN strings, and then default to "-", 0 and 1.
+// A malformed string is reported as a FenError together with the offset of the offending character. So is a
+// placement the rest of the engine cannot play from: a side without exactly one king, a pawn on the first or
+// eighth rank, or a player not to move left in check.
+
+#ifndef FEN_H
+#define FEN_H
+
+#include "Bitboard.h"
+#include "Color.h"
+#include <cstddef>
+#include <string_view>
+
+using namespace std;
+
+// Defining FenError enumeration, the reasons a FEN string can be rejected
+enum FenError {
+    FEN_OK,             // The string is valid
+    FEN_MISSING_FIELD,  // One of the first three fields is missing
+    FEN_BAD_PLACEMENT,  // The piece placement does not describe eight ranks of eight squares
+    FEN_BAD_KINGS,      // A side does not have exactly one king
+    FEN_BAD_PAWN,       // A pawn stands on the first or the eighth rank
+    FEN_BAD_SIDE,       // The side to move is neither "w" nor "b"
+    FEN_OTHER_IN_CHECK, // The player not to move is in check, so its king could be captured
+    FEN_BAD_CASTLING,   // The castling field is neither "-" nor made of the letters KQkq
+    FEN_BAD_EN_PASSANT, // The en passant field is neither "-" nor a square the side to move could capture on
+    FEN_BAD_HALFMOVE,   // The halfmove clock is not a number
+    FEN_BAD_FULLMOVE,   // The fullmove number is not a positive number
+    FEN_TRAILING_TEXT   // Something follows the sixth field
+};
+
+// FenResult is the outcome of parsing a FEN string
+struct FenResult {
+    FenError error = FEN_OK; // Reason the string was rejected, or FEN_OK
+    size_t offset = 0;       // Offset of the character where the error was found
+
+    // Checks if the string was valid
+    bool ok() const { return error == FEN_OK; }
+};
+
+// FenPosition holds the content of a FEN string
+struct FenPosition {
+    int board[SQUARE_NB];  // pieceIndex(color, type) of the piece on each square (0 is A1), or -1 if it is empty
+    Color sideToMove;      // Player to move
+    int castlingRights;    // CastlingRight bits of the rights listed
+    int enPassantSquare;   // Square a pawn skipped over on the last move, or -1
+    int halfmoveClock;     // Halfmoves since the last capture or pawn move
+    int fullmoveNumber;    // Number of the full move, starting at 1
+};
+
+// Parses a FEN string into 'position'. On error, 'position' is left partly filled and must not be used.
+FenResult parseFen(string_view fen, FenPosition& position);
+
+// Returns a readable description of a FenError
+const char* fenErrorMessage(FenError error);
+
+#endif // FEN_H
@@ -0,0 +1,26 @@
+// GameObserver.h
+// This file defines the GameObserver interface, through which ChessGame reports what happens in the game.
+// ChessGame itself never writes to the console: it hands every loaded state and every submitted move to its
+// observer, if one is attached, and the observer decides what to do with it (print it, log it, count it).
+// A game without an observer pays only for a null pointer check.
+
+#ifndef GAMEOBSERVER_H
+#define GAMEOBSERVER_H
+
+#include "Fen.h"
+#include "MoveResult.h"
+
+// GameObserver class receiving the events of a ChessGame. Every method does nothing unless overridden.
+class GameObserver {
+public:
+    // Virtual destructor
+    virtual ~GameObserver() {}
+
+    // Called after loadState, with the result of parsing the FEN string
+    virtual void onStateLoaded(const FenResult& result) { (void)result; }
+
+    // Called after a move is submitted, whether it was played or refused
+    virtual void onMove(const MoveResult& result) { (void)result; }
+};
+
+#endif // GAMEOBSERVER_H
@@ -0,0 +1,363 @@
+// GameSessionManager.cpp
+#include "GameSessionManager.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Number of latency buckets: 8 per power of two of nanoseconds, enough for any 64-bit duration
+static const int LATENCY_BUCKETS = 62 * 8;
+
+// SessionMove is a move waiting in a shard's queue
+struct SessionMove {
+    GameId game;                                   // Game the move belongs to
+    uint8_t from;                                  // Source square (0 is A1)
+    uint8_t to;                                    // Destination square
+    PieceType promotion;                           // Piece a pawn reaching the last rank promotes to
+    chrono::steady_clock::time_point submitted;    // Time submitMove was called, for the latency statistics
+};
+
+// SessionShard holds the games whose id falls in one shard, and the worker playing their moves.
+// The lock guards the queue, the free ids and the sessions of the shard.
+struct SessionShard {
+    mutex lock;
+    condition_variable wake;        // Signaled when a move is queued or the manager stops
+    condition_variable drained;     // Signaled when the queue has been played to the end
+    vector<SessionMove> queue;      // Moves submitted and not yet taken by the worker
+    vector<GameId> freeIds;         // Ids of the shard without a game, the next one to use last
+    size_t pending = 0;             // Moves submitted and not yet played or rejected
+    bool stopping = false;          // Set by the destructor to end the worker
+    thread worker;
+
+    atomic<uint64_t> played{0};                 // Number of moves played
+    atomic<uint64_t> rejected{0};               // Number of moves rejected
+    atomic<uint64_t> latency[LATENCY_BUCKETS];  // Number of moves by latency bucket, written by the worker only
+
+    SessionShard() {
+        for (atomic<uint64_t>& bucket : latency) {
+            bucket.store(0, memory_order_relaxed);
+        }
+    }
+};
+
+// Helper function to find the latency bucket of a duration in nanoseconds.
+// Durations under 8 ns have a bucket each; above that, each power of two is split into 8 buckets.
+static int latencyBucket(uint64_t nanoseconds) {
+    if (nanoseconds < 8) {
+        return int(nanoseconds);
+    }
+    int octave = 63 - __builtin_clzll(nanoseconds);
+    return (octave - 2) * 8 + int((nanoseconds >> (octave - 3)) & 7);
+}
+
+// Helper function returning the largest duration in nanoseconds that falls in a latency bucket
+static uint64_t latencyBucketLimit(int bucket) {
+    if (bucket < 8) {
+        return uint64_t(bucket);
+    }
+    int octave = bucket / 8 + 2;
+    uint64_t start = (uint64_t(8 + bucket % 8)) << (octave - 3);
+    return start + (1ULL << (octave - 3)) - 1;
+}
+
+// Constructor that allocates the game slots and starts the workers.
+// Every id is handed to the free list of its shard up front, lowest ids used first.
+GameSessionManager::GameSessionManager(size_t capacity, int shardCount)
+    : sessions(capacity), nextShard(0), liveGames(0), moveCallback(nullptr) {
+    if (shardCount <= 0) {
+        shardCount = max(1, int(thread::hardware_concurrency()));
+    }
+    for (GameSession& session : sessions) {
+        session.status = ONGOING;
+        session.plies = 0;
+        session.generation = 0;
+        session.keyStart = 0;
+        session.keyCount = 0;
+        session.live = false;
+    }
+    for (int i = 0; i < shardCount; ++i) {
+        shards.emplace_back(new SessionShard());
+    }
+    for (size_t id = capacity; id-- > 0;) {
+        shards[id % shardCount]->freeIds.push_back(GameId(id));
+    }
+    for (unique_ptr<SessionShard>& shard : shards) {
+        SessionShard* target = shard.get();
+        shard->worker = thread([this, target]() { work(*target); });
+    }
+}
+
+// Destructor that lets every worker finish its queue before joining it
+GameSessionManager::~GameSessionManager() {
+    for (unique_ptr<SessionShard>& shard : shards) {
+        lock_guard<mutex> guard(shard->lock);
+        shard->stopping = true;
+        shard->wake.notify_one();
+    }
+    for (unique_ptr<SessionShard>& shard : shards) {
+        shard->worker.join();
+    }
+}
+
+// Setter for the function called after each move
+void GameSessionManager::setMoveCallback(SessionMoveCallback callback) {
+    moveCallback = callback;
+}
+
+// Helper function to find the shard of a game
+SessionShard& GameSessionManager::shardOf(GameId game) const {
+    return *shards[game % shards.size()];
+}
+
+// Method to start a new game.
+// The FEN string is parsed by a scratch game before any lock is taken. Shards are tried in turn from the next one
+// in the round robin, so that games spread evenly and a full shard does not make the manager look full.
+GameId GameSessionManager::createGame(string_view fen) {
+    ChessGame game;
+    if (!game.setState(fen).ok()) {
+        return NO_GAME;
+    }
+    BoardState state = game.snapshot();
+    GameStatus status = game.getGameStatus();
+
+    uint32_t first = nextShard.fetch_add(1, memory_order_relaxed);
+    for (size_t i = 0; i < shards.size(); ++i) {
+        SessionShard& shard = *shards[(first + i) % shards.size()];
+        lock_guard<mutex> guard(shard.lock);
+        if (shard.freeIds.empty()) {
+            continue;
+        }
+        GameId id = shard.freeIds.back();
+        shard.freeIds.pop_back();
+
+        GameSession& session = sessions[id];
+        session.state = state;
+        session.keyStart = 0;
+        session.keyCount = 0;
+        session.status = status;
+        session.plies = 0;
+        session.generation++;
+        session.live = true;
+        liveGames.fetch_add(1, memory_order_relaxed);
+        return id;
+    }
+    return NO_GAME;
+}
+
+// Method to end a game and give its id back to its shard
+void GameSessionManager::closeGame(GameId game) {
+    if (game >= sessions.size()) {
+        return;
+    }
+    SessionShard& shard = shardOf(game);
+    lock_guard<mutex> guard(shard.lock);
+    if (sessions[game].live) {
+        sessions[game].live = false;
+        shard.freeIds.push_back(game);
+        liveGames.fetch_sub(1, memory_order_relaxed);
+    }
+}
+
+// Method to queue a move for the worker of the game's shard
+bool GameSessionManager::submitMove(GameId game, const Position& from, const Position& to, PieceType promotion) {
+    if (game >= sessions.size() || !from.isValid() || !to.isValid()) {
+        return false;
+    }
+    SessionShard& shard = shardOf(game);
+    lock_guard<mutex> guard(shard.lock);
+    if (!sessions[game].live) {
+        return false;
+    }
+    shard.queue.push_back({game, uint8_t(squareOf(from)), uint8_t(squareOf(to)), promotion, chrono::steady_clock::now()});
+    if (shard.pending++ == 0) {
+        shard.wake.notify_one();
+    }
+    return true;
+}
+
+// Method to wait until every shard has played all the moves submitted to it
+void GameSessionManager::flush() {
+    for (unique_ptr<SessionShard>& shard : shards) {
+        unique_lock<mutex> guard(shard->lock);
+        shard->drained.wait(guard, [&shard]() { return shard->pending == 0; });
+    }
+}
+
+// Helper function run by the worker of a shard.
+// The worker takes the whole queue at once and plays it without holding the lock, taking it only briefly to read
+// a game before each move and to write it back after. The game is played on a scratch ChessGame restored from the
+// session's position and the hashes of the positions before it, so the rules are exactly those of playMove,
+// threefold repetition included. Only this worker writes the sessions' positions and hashes, so a game closed and
+// created again in between is detected by its generation and left alone, and the hashes can be read without the
+// lock: the lock only guards where the ring starts and how many hashes it holds.
+void GameSessionManager::work(SessionShard& shard) {
+    ChessGame game;
+    vector<SessionMove> batch;
+    vector<uint64_t> keys;
+    keys.reserve(SESSION_KEYS);
+    unique_lock<mutex> guard(shard.lock);
+    while (true) {
+        shard.wake.wait(guard, [&shard]() { return shard.stopping || !shard.queue.empty(); });
+        if (shard.queue.empty()) {
+            return; // Stopping, and nothing left to play
+        }
+        batch.swap(shard.queue);
+        guard.unlock();
+
+        for (const SessionMove& move : batch) {
+            GameSession& session = sessions[move.game];
+            MoveResult result;
+            result.from = positionOf(move.from);
+            result.to = positionOf(move.to);
+            bool live;
+            uint32_t generation;
+            BoardState state;
+            int keyStart;
+            int keyCount;
+            {
+                lock_guard<mutex> sessionGuard(shard.lock);
+                live = session.live;
+                generation = session.generation;
+                state = session.state;
+                keyStart = session.keyStart;
+                keyCount = session.keyCount;
+            }
+            if (live) {
+                keys.clear();
+                for (int i = 0; i < keyCount; ++i) {
+                    keys.push_back(session.keys[(keyStart + i) % SESSION_KEYS]);
+                }
+                game.restore(state, keys);
+                result = game.playMove(result.from, result.to, move.promotion);
+            } else {
+                result.outcome = MOVE_NO_PIECE; // The game was closed after the move was submitted
+            }
+            if (result.ok()) {
+                lock_guard<mutex> sessionGuard(shard.lock);
+                if (session.live && session.generation == generation) {
+                    // A capture or pawn move starts the positions that can repeat afresh. Otherwise the position
+                    // before the move joins the ring, which drops the hashes older than the halfmove clock.
+                    int halfmoveClock = game.getHalfmoveClock();
+                    if (halfmoveClock == 0) {
+                        session.keyStart = 0;
+                        session.keyCount = 0;
+                    } else {
+                        session.keys[(session.keyStart + session.keyCount) % SESSION_KEYS] = state.positionKey;
+                        if (session.keyCount < min(halfmoveClock, SESSION_KEYS)) {
+                            session.keyCount++;
+                        } else {
+                            session.keyStart = uint8_t((session.keyStart + 1) % SESSION_KEYS);
+                        }
+                    }
+                    session.state = game.snapshot();
+                    session.status = result.status;
+                    session.plies++;
+                }
+            }
+
+            (result.ok() ? shard.played : shard.rejected).fetch_add(1, memory_order_relaxed);
+            uint64_t nanoseconds = chrono::duration_cast<chrono::nanoseconds>(
+                chrono::steady_clock::now() - move.submitted).count();
+            shard.latency[latencyBucket(nanoseconds)].fetch_add(1, memory_order_relaxed);
+            if (moveCallback != nullptr) {
+                moveCallback(move.game, result);
+            }
+        }
+
+        guard.lock();
+        shard.pending -= batch.size();
+        batch.clear();
+        if (shard.pending == 0) {
+            shard.drained.notify_all();
+        }
+    }
+}
+
+// Getter for the status of the player to move in a game
+GameStatus GameSessionManager::getStatus(GameId game) const {
+    if (game >= sessions.size()) {
+        return ONGOING;
+    }
+    lock_guard<mutex> guard(shardOf(game).lock);
+    return sessions[game].live ? sessions[game].status : ONGOING;
+}
+
+// Getter for the position of a game and the number of moves played in it
+bool GameSessionManager::getState(GameId game, BoardState& state, uint32_t& plies) const {
+    if (game >= sessions.size()) {
+        return false;
+    }
+    lock_guard<mutex> guard(shardOf(game).lock);
+    if (!sessions[game].live) {
+        return false;
+    }
+    state = sessions[game].state;
+    plies = sessions[game].plies;
+    return true;
+}
+
+// Getter for the number of games hosted
+size_t GameSessionManager::getLiveGames() const {
+    return liveGames.load(memory_order_relaxed);
+}
+
+// Getter for the most games that can be hosted
+size_t GameSessionManager::getCapacity() const {
+    return sessions.size();
+}
+
+// Getter for the number of shards
+int GameSessionManager::getShardCount() const {
+    return int(shards.size());
+}
+
+// Method to compute the memory used by the game slots. A slot holds its game's hashes inline, so its size is the
+// whole cost of a game.
+size_t GameSessionManager::getSessionMemory() const {
+    return sessions.size() * sizeof(GameSession);
+}
+
+// Getter for the number of moves played, over all shards
+uint64_t GameSessionManager::getMovesPlayed() const {
+    uint64_t total = 0;
+    for (const unique_ptr<SessionShard>& shard : shards) {
+        total += shard->played.load(memory_order_relaxed);
+    }
+    return total;
+}
+
+// Getter for the number of moves rejected, over all shards
+uint64_t GameSessionManager::getMovesRejected() const {
+    uint64_t total = 0;
+    for (const unique_ptr<SessionShard>& shard : shards) {
+        total += shard->rejected.load(memory_order_relaxed);
+    }
+    return total;
+}
+
+// Method to find a latency percentile from the bucket counts of all shards.
+// The returned value is the upper limit of the bucket the percentile falls in.
+uint64_t GameSessionManager::latencyPercentile(double fraction) const {
+    uint64_t counts[LATENCY_BUCKETS] = {};
+    uint64_t total = 0;
+    for (const unique_ptr<SessionShard>& shard : shards) {
+        for (int bucket = 0; bucket < LATENCY_BUCKETS; ++bucket) {
+            uint64_t count = shard->latency[bucket].load(memory_order_relaxed);
+            counts[bucket] += count;
+            total += count;
+        }
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    uint64_t rank = min(total - 1, uint64_t(fraction * double(total)));
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < LATENCY_BUCKETS; ++bucket) {
+        seen += counts[bucket];
+        if (seen > rank) {
+            return latencyBucketLimit(bucket);
+        }
+    }
+    return latencyBucketLimit(LATENCY_BUCKETS - 1);
+}
@@ -0,0 +1,124 @@
+// GameSessionManager.h
+// This file defines the GameSessionManager class, which hosts many games at once for a server.
+// A game is kept as a GameSession holding its BoardState and the hashes of its positions since the last capture or
+// pawn move, which the repetition rule is checked against, so a hosted game costs a fixed size with no heap memory.
+// All sessions live in one array allocated up front, and a game id is an index into it.
+// The games are split into shards by id. Each shard has its own lock, its own queue of submitted moves and its own
+// worker thread, which plays the moves of its games on a scratch ChessGame in the order they were submitted.
+// No lock is shared by all games, so clients working on games of different shards never wait for each other.
+
+#ifndef GAMESESSIONMANAGER_H
+#define GAMESESSIONMANAGER_H
+
+#include "ChessGame.h"
+#include "GameStatus.h"
+#include "MoveResult.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// Identifier of a game hosted by a GameSessionManager. Ids of closed games are given to new games again.
+typedef uint32_t GameId;
+
+// Marks the absence of a game
+const GameId NO_GAME = UINT32_MAX;
+
+// Most position hashes a session keeps. Only the positions since the last capture or pawn move can repeat, and
+// the fifty-move rule ends the game once there are 100 of them.
+const int SESSION_KEYS = 100;
+
+// GameSession is the slot of one hosted game
+struct GameSession {
+    BoardState state;             // Position of the game
+    uint64_t keys[SESSION_KEYS];  // Ring of the hashes of the positions since the last capture or pawn move
+    GameStatus status;            // Status of the player to move
+    uint32_t plies;               // Number of moves played since the game was created
+    uint32_t generation;          // Incremented with each new game in the slot, so a worker can tell it was replaced
+    uint8_t keyStart;             // Index in keys of the oldest hash
+    uint8_t keyCount;             // Number of hashes in keys
+    bool live;                    // Whether the slot holds a game
+};
+
+// A slot owns no heap memory, so the slots alone account for the memory of the hosted games
+static_assert(is_trivially_copyable<GameSession>::value, "GameSession must not own heap memory");
+static_assert(sizeof(GameSession) <= 1024, "GameSession should stay within 1 KB per hosted game");
+
+// Function called by a worker thread after each submitted move, whether it was played or not
+typedef void (*SessionMoveCallback)(GameId game, const MoveResult& result);
+
+struct SessionShard;
+
+// GameSessionManager class hosting a fixed maximum number of games and playing their moves on worker threads
+class GameSessionManager {
+private:
+    vector<GameSession> sessions;             // One slot per game id, allocated once
+    vector<unique_ptr<SessionShard>> shards;  // Shard of each game id is id % shards.size()
+    atomic<uint32_t> nextShard;               // Shard the next game is created in, round robin
+    atomic<size_t> liveGames;                 // Number of games currently hosted
+    SessionMoveCallback moveCallback;         // Called after each move, or nullptr
+
+    // Returns the shard holding a game
+    SessionShard& shardOf(GameId game) const;
+
+    // Plays the moves submitted to a shard until the manager is destroyed
+    void work(SessionShard& shard);
+
+public:
+    // Constructor that allocates room for 'capacity' games split into 'shardCount' shards, and starts one worker
+    // thread per shard. A shard count of 0 uses one shard per hardware thread.
+    GameSessionManager(size_t capacity, int shardCount = 0);
+
+    // Destructor that plays the moves still queued, then stops the worker threads
+    ~GameSessionManager();
+
+    // The manager owns its threads, so it cannot be copied
+    GameSessionManager(const GameSessionManager&) = delete;
+    GameSessionManager& operator=(const GameSessionManager&) = delete;
+
+    // Sets the function called after each move, or nullptr for none. Set it before submitting any move.
+    void setMoveCallback(SessionMoveCallback callback);
+
+    // Starts a game from a FEN string and returns its id, or NO_GAME if the string is invalid or there is no room
+    GameId createGame(string_view fen = START_FEN);
+
+    // Ends a game, making its id free for a new game. Moves of the game still queued are rejected.
+    void closeGame(GameId game);
+
+    // Queues a move of a game for its shard's worker and returns at once. Returns false if the game is not hosted.
+    // A pawn reaching the last rank promotes to 'promotion', which must be a knight, bishop, rook or queen.
+    // The outcome is passed to the move callback, and the game's state and status reflect it once it is played.
+    bool submitMove(GameId game, const Position& from, const Position& to, PieceType promotion = QUEEN);
+
+    // Waits until every move submitted so far has been played or rejected
+    void flush();
+
+    // Returns the status of the player to move in a game, or ONGOING if the game is not hosted
+    GameStatus getStatus(GameId game) const;
+
+    // Returns the position of a game and the number of moves played in it. Returns false if the game is not hosted.
+    bool getState(GameId game, BoardState& state, uint32_t& plies) const;
+
+    // Getters for the number of games hosted, the most that can be hosted, and the number of shards
+    size_t getLiveGames() const;
+    size_t getCapacity() const;
+    int getShardCount() const;
+
+    // Returns the memory used by the game slots in bytes, which is all the memory the hosted games use
+    size_t getSessionMemory() const;
+
+    // Getters for the number of submitted moves played and rejected so far, over all shards
+    uint64_t getMovesPlayed() const;
+    uint64_t getMovesRejected() const;
+
+    // Returns the time in nanoseconds under which the given fraction (e.g., 0.99) of the moves were played,
+    // counted from submitMove to the end of the move. The value is exact to within 1/8.
+    uint64_t latencyPercentile(double fraction) const;
+};
+
+#endif // GAMESESSIONMANAGER_H
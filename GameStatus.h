@@ -0,0 +1,38 @@
+// GameStatus.h
+#ifndef GAMESTATUS_H
+#define GAMESTATUS_H
+
+// Defining GameStatus enumeration, describing the situation of the player to move
+enum GameStatus {
+    ONGOING,                // The player has legal moves and is not in check
+    CHECK,                  // The player is in check but can escape it
+    CHECKMATE,              // The player is in check and has no legal move
+    STALEMATE,              // The player is not in check and has no legal move
+    FIFTY_MOVE_DRAW,        // Drawn: fifty moves by each side without a capture or a pawn move
+    THREEFOLD_REPETITION,   // Drawn: the position occurred for the third time with the same player to move
+    INSUFFICIENT_MATERIAL,  // Drawn: neither side has the pieces left to checkmate
+    SEVENTY_FIVE_MOVE_DRAW, // Drawn: seventy-five moves by each side without a capture or a pawn move
+    FIVEFOLD_REPETITION     // Drawn: the position occurred for the fifth time with the same player to move
+};
+
+// Checks if a status ends the game
+inline bool isGameOver(GameStatus status) {
+    return status != ONGOING && status != CHECK;
+}
+
+// Checks if a status ends the game without either player claiming it. The fifty-move draw and threefold
+// repetition only give the right to claim a draw, so the game may go on after them.
+inline bool endsAutomatically(GameStatus status) {
+    return status == CHECKMATE || status == STALEMATE || status == INSUFFICIENT_MATERIAL
+        || status == SEVENTY_FIVE_MOVE_DRAW || status == FIVEFOLD_REPETITION;
+}
+
+// Returns the lowercase name of a status (e.g., "checkmate")
+inline const char* gameStatusName(GameStatus status) {
+    static const char* const names[] = {"ongoing", "check", "checkmate", "stalemate",
+                                        "fifty-move-draw", "threefold-repetition", "insufficient-material",
+                                        "seventy-five-move-draw", "fivefold-repetition"};
+    return names[status];
+}
+
+#endif // GAMESTATUS_H
@@ -0,0 +1,151 @@
+// GameValidator.cpp
+#include "GameValidator.h"
+
+// Helper function to split the next space-separated token off the front of 'text'
+static string_view nextToken(string_view& text) {
+    size_t start = text.find_first_not_of(" \t\r");
+    if (start == string_view::npos) {
+        text = string_view();
+        return string_view();
+    }
+    size_t end = text.find_first_of(" \t\r", start);
+    if (end == string_view::npos) {
+        end = text.size();
+    }
+    string_view token = text.substr(start, end - start);
+    text.remove_prefix(end);
+    return token;
+}
+
+// Helper function to find the legal move written as 'text' in coordinate notation.
+// The move is compared by its squares and promotion piece, so the text does not need to say whether it castles.
+ChessMove GameValidator::findMove(string_view text) const {
+    if (text.size() != 4 && text.size() != 5) {
+        return ChessMove();
+    }
+    for (int i = 0; i < 4; i += 2) {
+        if (text[i] < 'a' || text[i] > 'h' || text[i + 1] < '1' || text[i + 1] > '8') {
+            return ChessMove();
+        }
+    }
+    int from = (text[1] - '1') * 8 + (text[0] - 'a');
+    int to = (text[3] - '1') * 8 + (text[2] - 'a');
+    char promotion = (text.size() == 5) ? text[4] : 0;
+
+    MoveList moves;
+    game.generateLegalMoves(moves);
+    for (const ChessMove& move : moves) {
+        if (move.getFrom() != from || move.getTo() != to) {
+            continue;
+        }
+        bool isPromotion = (move.getType() == PROMOTION);
+        if ((!isPromotion && promotion == 0) || (isPromotion && promotion == "nbrq"[move.getPromotion() - KNIGHT])) {
+            return move;
+        }
+    }
+    return ChessMove();
+}
+
+// Helper function to play one move of a game. Only an ending that needs no claim stops the game: a draw by the
+// fifty-move rule or threefold repetition may be played on. Such a draw is caught before the move is looked up, and
+// a checkmate or stalemate, which leave no legal move to find, only when the lookup fails, so the legal moves are
+// generated once per move.
+bool GameValidator::playMove(string_view text, ValidationResult& result) {
+    ChessMove move = endsAutomatically(game.drawStatus()) ? ChessMove() : findMove(text);
+    if (move.isNull()) {
+        result.outcome = endsAutomatically(game.getGameStatus()) ? GAME_AFTER_END : GAME_ILLEGAL_MOVE;
+        return false;
+    }
+    game.makeMove(move);
+    ++result.plies;
+    return true;
+}
+
+// Helper function to play the moves of a game until the first one that cannot be played
+ValidationResult GameValidator::replay(string_view text, string_view* failedMove) {
+    ValidationResult result;
+    for (string_view token = nextToken(text); !token.empty(); token = nextToken(text)) {
+        if (!playMove(token, result)) {
+            if (failedMove != nullptr) {
+                *failedMove = token;
+            }
+            break;
+        }
+    }
+    result.finalStatus = game.getGameStatus();
+    return result;
+}
+
+// Method to check a game given as a starting FEN and a list of moves
+ValidationResult GameValidator::validate(const string& fen, const vector<string>& moves) {
+    ValidationResult result;
+    if (!game.setState(fen).ok()) {
+        result.outcome = GAME_INVALID_FEN;
+        return result;
+    }
+    for (const string& text : moves) {
+        if (!playMove(text, result)) {
+            break;
+        }
+    }
+    result.finalStatus = game.getGameStatus();
+    return result;
+}
+
+// Method to check a game given as one line
+ValidationResult GameValidator::validateLine(const string& line) {
+    return validateLine(line, nullptr);
+}
+
+// Helper function to check a game given as one line: the FEN runs up to the "moves" keyword
+ValidationResult GameValidator::validateLine(string_view line, string_view* failedMove) {
+    string_view fen = line;
+    string_view moves;
+    size_t keyword = line.find("moves");
+    if (keyword != string_view::npos) {
+        fen = line.substr(0, keyword);
+        moves = line.substr(keyword + 5);
+    }
+
+    string_view rest = fen;
+    string_view first = nextToken(rest);
+    bool loaded = game.setState((first == "startpos") ? string_view(START_FEN) : fen).ok();
+    if (!loaded) {
+        ValidationResult result;
+        result.outcome = GAME_INVALID_FEN;
+        return result;
+    }
+    return replay(moves, failedMove);
+}
+
+// Method to check a stream of games, one per line
+uint64_t GameValidator::validateStream(istream& in, ostream& out) {
+    uint64_t games = 0;
+    string line;
+    while (getline(in, line)) {
+        if (line.find_first_not_of(" \t\r") == string::npos) {
+            continue;
+        }
+        ++games;
+
+        string_view failedMove;
+        ValidationResult result = validateLine(line, &failedMove);
+        out << games << ' ';
+        switch (result.outcome) {
+            case GAME_LEGAL:
+                out << "legal " << result.plies << ' ' << gameStatusName(result.finalStatus) << '\n';
+                break;
+            case GAME_ILLEGAL_MOVE:
+                out << "illegal " << result.plies + 1 << ' ' << failedMove << '\n';
+                break;
+            case GAME_AFTER_END:
+                out << "after-end " << result.plies + 1 << ' ' << failedMove << ' '
+                    << gameStatusName(result.finalStatus) << '\n';
+                break;
+            case GAME_INVALID_FEN:
+                out << "invalid-fen\n";
+                break;
+        }
+    }
+    return games;
+}
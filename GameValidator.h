@@ -0,0 +1,72 @@
+// GameValidator.h
+// This file defines the GameValidator class, which checks whole games against the rules of ChessGame in bulk.
+// A game is a starting position in FEN together with its moves in coordinate notation (e.g., "e2e4", "e7e8q").
+// Each move is matched against the legal moves of the position and played without any console output,
+// and the result of the game (legal, or illegal at which ply) is returned as data.
+
+#ifndef GAMEVALIDATOR_H
+#define GAMEVALIDATOR_H
+
+#include "ChessGame.h"
+#include "ChessMove.h"
+#include "GameStatus.h"
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// Defining ValidationOutcome enumeration, the verdict on a game
+enum ValidationOutcome {
+    GAME_LEGAL,        // Every move is legal
+    GAME_ILLEGAL_MOVE, // A move is malformed or not legal in its position
+    GAME_AFTER_END,    // A move follows checkmate, stalemate or a draw that needs no claim
+    GAME_INVALID_FEN   // The starting position could not be loaded
+};
+
+// ValidationResult holds the verdict on one game
+struct ValidationResult {
+    ValidationOutcome outcome = GAME_LEGAL; // Verdict on the game
+    int plies = 0;                          // Number of moves played before the game ended or failed
+    GameStatus finalStatus = ONGOING;       // Status of the player to move after the last legal move, including
+                                            // a draw that could be claimed; with GAME_AFTER_END, how the game ended
+};
+
+// GameValidator class checking games one after another on a single reused ChessGame
+class GameValidator {
+private:
+    ChessGame game; // Board the games are replayed on
+
+    // Finds the legal move written as 'text' in the current position. Returns the null move if there is none.
+    ChessMove findMove(string_view text) const;
+
+    // Plays the move written as 'text' and counts it in 'result'. Returns false, with the outcome set in 'result',
+    // if the game has ended without a claim or the move is not legal.
+    bool playMove(string_view text, ValidationResult& result);
+
+    // Plays the moves of 'text', separated by spaces, from the current position until one is not legal.
+    // The text of that move is stored in 'failedMove' if it is not nullptr.
+    ValidationResult replay(string_view text, string_view* failedMove);
+
+    // Checks a game given as one line, storing the text of an illegal move in 'failedMove' if it is not nullptr
+    ValidationResult validateLine(string_view line, string_view* failedMove);
+
+public:
+    // Checks a game given as a starting FEN and a list of moves
+    ValidationResult validate(const string& fen, const vector<string>& moves);
+
+    // Checks a game given as one line: a FEN or "startpos", then "moves" and the moves separated by spaces
+    ValidationResult validateLine(const string& line);
+
+    // Checks every non-empty line of 'in' as a game and writes one result line per game to 'out':
+    //   <game number> legal <plies> <final status>
+    //   <game number> illegal <ply> <move>
+    //   <game number> after-end <ply> <move> <final status>
+    //   <game number> invalid-fen
+    // Returns the number of games checked.
+    uint64_t validateStream(istream& in, ostream& out);
+};
+
+#endif // GAMEVALIDATOR_H
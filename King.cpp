@@ -3,7 +3,7 @@
 #include "ChessGame.h"
 
 // Constructor that sets the color of the king
-King::King(Color pieceColor) : ChessPiece(pieceColor), hasMoved(false) {
+King::King(Color pieceColor) : ChessPiece(pieceColor) {
 }
 
 // Destructor, ensures proper cleanup for King objects
@@ -31,13 +31,3 @@ bool King::isValidMove(const Position& from, const Position& to, const ChessGame
     // A valid king move is one square in any direction
     return (rowDifference <= 1 && colDifference <= 1) && (rowDifference + colDifference > 0);
 }
-
-// Method to set the moved status of the king
-void King::setMoved() {
-    hasMoved = true;
-}
-
-// Method to check if the king has moved before
-bool King::hasMovedBefore() const {
-    return hasMoved;
-}
\ No newline at end of file
@@ -10,9 +10,6 @@
 
 // King class representing a king chess piece
 class King : public ChessPiece {
-private:
-    bool hasMoved;  // Attribute to track if the king has moved --> for "Castling"
-
 public:
     // Constructor that sets the color of the king
     King(Color pieceColor);
@@ -29,12 +26,6 @@ public:
     // Checks if the move from 'from' position to 'to' position is valid for the king.
     // A king moves one square in any direction. Additionally, castling is allowed under specific conditions.
     bool isValidMove(const Position& from, const Position& to, const ChessGame& game) const override;
-
-    // Marks the king as having moved, which affects the availability of castling in the game
-    void setMoved();
-
-    // Checks if the king has moved before; used to determine if castling is allowed
-    bool hasMovedBefore() const;
 };
 
 #endif // KING_H
\ No newline at end of file
@@ -28,4 +28,4 @@ bool Knight::isValidMove(const Position& from, const Position& to, const ChessGa
 
     // A valid knight move is either two squares in one direction and one in the other
     return (rowDifference == 2 && colDifference == 1) || (rowDifference == 1 && colDifference == 2);
-} 
\ No newline at end of file
+} 
@@ -0,0 +1,43 @@
+// MoveResult.h
+// This file defines MoveResult, the structured outcome of a move submitted to ChessGame: whether it was played,
+// why it was refused if it was not, what it captured and what it left the opponent facing.
+
+#ifndef MOVERESULT_H
+#define MOVERESULT_H
+
+#include "Position.h"
+#include "Color.h"
+#include "Bitboard.h"
+#include "GameStatus.h"
+
+// Defining MoveOutcome enumeration, telling whether a submitted move was played and why not
+enum MoveOutcome {
+    MOVE_OK,                // The move was played
+    MOVE_NO_PIECE,          // There is no piece on the source square
+    MOVE_WRONG_TURN,        // The piece belongs to the player who is not to move
+    MOVE_ILLEGAL,           // The piece cannot move to the destination square
+    MOVE_OWN_KING_IN_CHECK, // The move would leave the player's own king in check
+    CASTLING_KING_MOVED,    // Castling refused: the king is not on its original square or has moved
+    CASTLING_ROOK_MOVED,    // Castling refused: the rook is not on its original square or has moved
+    CASTLING_RIGHT_LOST,    // Castling refused: the player no longer holds the castling right
+    CASTLING_IN_CHECK,      // Castling refused: the king is in check
+    CASTLING_PATH_BLOCKED   // Castling refused: a square between king and rook is occupied or the king passes through attack
+};
+
+// MoveResult describes what happened to a submitted move
+struct MoveResult {
+    MoveOutcome outcome = MOVE_OK;        // Whether the move was played, and why not
+    Position from;                        // Source square as submitted
+    Position to;                          // Destination square as submitted
+    Color color = WHITE;                  // Color of the piece on the source square
+    PieceType piece = PIECE_TYPE_NB;      // Type of the piece on the source square, or PIECE_TYPE_NB if there is none
+    PieceType captured = PIECE_TYPE_NB;   // Type of the captured piece, or PIECE_TYPE_NB if nothing was captured
+    PieceType promotion = PIECE_TYPE_NB;  // Piece a pawn promoted to, or PIECE_TYPE_NB if the move is no promotion
+    bool castling = false;                // Whether the move is a castling attempt
+    GameStatus status = ONGOING;          // Situation of the opponent after a played move
+
+    // Checks if the move was played
+    bool ok() const { return outcome == MOVE_OK; }
+};
+
+#endif // MOVERESULT_H
@@ -0,0 +1,286 @@
+// Nnue.cpp
+#include "Nnue.h"
+#include "ChessGame.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Helper function to get the input of a piece on a square, seen from the given side.
+// From Black's side the board is mirrored vertically and the colors are swapped.
+static int featureIndex(Color perspective, Piece piece, int square) {
+    int side = (colorOf(piece) == perspective) ? 0 : 1;
+    int relativeSquare = (perspective == WHITE) ? square : square ^ 56;
+    return (side * PIECE_TYPE_NB + typeOf(piece)) * SQUARE_NB + relativeSquare;
+}
+
+// Helper function to add a weight column to the hidden sums, or to subtract it with 'subtract'.
+// Both the sums and the columns are aligned to 32 bytes.
+static void applyColumn(int16_t* values, const int16_t* column, bool subtract) {
+#if defined(__AVX2__)
+    for (int i = 0; i < NNUE_HIDDEN; i += 16) {
+        __m256i* sums = (__m256i*)(values + i);
+        __m256i weights = _mm256_load_si256((const __m256i*)(column + i));
+        *sums = subtract ? _mm256_sub_epi16(*sums, weights) : _mm256_add_epi16(*sums, weights);
+    }
+#elif defined(__SSE2__)
+    for (int i = 0; i < NNUE_HIDDEN; i += 8) {
+        __m128i* sums = (__m128i*)(values + i);
+        __m128i weights = _mm_load_si128((const __m128i*)(column + i));
+        *sums = subtract ? _mm_sub_epi16(*sums, weights) : _mm_add_epi16(*sums, weights);
+    }
+#else
+    for (int i = 0; i < NNUE_HIDDEN; ++i) {
+        values[i] = int16_t(subtract ? values[i] - column[i] : values[i] + column[i]);
+    }
+#endif
+}
+
+// Helper function to clip the hidden sums to [0, NNUE_QA] and return their dot product with the weights.
+// The clipped sums fit in 16 bits, so pairs of products are added into 32-bit lanes by one madd instruction.
+static int32_t clippedDot(const int16_t* values, const int16_t* weights) {
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i limit = _mm256_set1_epi16(NNUE_QA);
+    __m256i sum = _mm256_setzero_si256();
+    for (int i = 0; i < NNUE_HIDDEN; i += 16) {
+        __m256i clipped = _mm256_min_epi16(_mm256_max_epi16(_mm256_load_si256((const __m256i*)(values + i)), zero), limit);
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(clipped, _mm256_load_si256((const __m256i*)(weights + i))));
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(half);
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i limit = _mm_set1_epi16(NNUE_QA);
+    __m128i sum = _mm_setzero_si128();
+    for (int i = 0; i < NNUE_HIDDEN; i += 8) {
+        __m128i clipped = _mm_min_epi16(_mm_max_epi16(_mm_load_si128((const __m128i*)(values + i)), zero), limit);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(clipped, _mm_load_si128((const __m128i*)(weights + i))));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+#else
+    int32_t sum = 0;
+    for (int i = 0; i < NNUE_HIDDEN; ++i) {
+        sum += min(max(int(values[i]), 0), NNUE_QA) * weights[i];
+    }
+    return sum;
+#endif
+}
+
+// Constructor that allocates the weights, all at zero
+NnueNetwork::NnueNetwork() : weights(new NnueWeights()) {
+}
+
+// Method to load the weights from a network file.
+// They are read into a new block that replaces the current one only once the whole file has been read.
+bool NnueNetwork::load(const string& path) {
+    ifstream file(path, ios::binary);
+    if (!file) {
+        return false;
+    }
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t hidden = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&hidden), sizeof(hidden));
+    if (!file || memcmp(magic, "NNUE", 4) != 0 || version != NNUE_VERSION || hidden != uint32_t(NNUE_HIDDEN)) {
+        return false;
+    }
+
+    unique_ptr<NnueWeights> loaded(new NnueWeights());
+    file.read(reinterpret_cast<char*>(loaded->featureWeights), sizeof(loaded->featureWeights));
+    file.read(reinterpret_cast<char*>(loaded->featureBiases), sizeof(loaded->featureBiases));
+    file.read(reinterpret_cast<char*>(loaded->outputWeights), sizeof(loaded->outputWeights));
+    file.read(reinterpret_cast<char*>(&loaded->outputBias), sizeof(loaded->outputBias));
+    if (!file) {
+        return false;
+    }
+    weights = move(loaded);
+    return true;
+}
+
+// Method to write the weights to a network file
+bool NnueNetwork::save(const string& path) const {
+    ofstream file(path, ios::binary);
+    if (!file) {
+        return false;
+    }
+    uint32_t version = NNUE_VERSION;
+    uint32_t hidden = NNUE_HIDDEN;
+    file.write("NNUE", 4);
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&hidden), sizeof(hidden));
+    file.write(reinterpret_cast<const char*>(weights->featureWeights), sizeof(weights->featureWeights));
+    file.write(reinterpret_cast<const char*>(weights->featureBiases), sizeof(weights->featureBiases));
+    file.write(reinterpret_cast<const char*>(weights->outputWeights), sizeof(weights->outputWeights));
+    file.write(reinterpret_cast<const char*>(&weights->outputBias), sizeof(weights->outputBias));
+    return bool(file);
+}
+
+// Method to fill the weights with pseudo-random values.
+// The ranges keep the hidden sums of ordinary positions within the clipping range and the scores within a few pawns.
+void NnueNetwork::randomize(uint64_t seed) {
+    mt19937_64 generator(seed);
+    uniform_int_distribution<int> weight(-16, 16);
+    for (int16_t& value : weights->featureWeights) {
+        value = int16_t(weight(generator));
+    }
+    for (int16_t& value : weights->featureBiases) {
+        value = int16_t(weight(generator));
+    }
+    for (int16_t& value : weights->outputWeights) {
+        value = int16_t(weight(generator));
+    }
+    weights->outputBias = 0;
+}
+
+// Constructor that binds the evaluator to a network
+NnueEvaluator::NnueEvaluator(const NnueNetwork& network) : network(network), refreshes(0), updates(0) {
+}
+
+// Method to find or compute the accumulator of the game's current position.
+// Accumulator i belongs to the position i plies after the game's state was loaded, and the undo records hold the
+// hash of each of those positions, so an accumulator is only used for the position it was computed for, even after
+// the game has taken moves back and played others. Starting from the latest ply whose accumulator is still valid,
+// the accumulators of the plies up to the current one are updated move by move; when none is valid within
+// NNUE_MAX_UPDATE_PLIES, the current one is refreshed from the pieces instead. The positions evaluated next usually
+// share the plies before the refreshed one, so their accumulators are then worked back out of it by taking the moves
+// back, which costs a few columns per ply instead of a refresh for each of those positions.
+const NnueAccumulator& NnueEvaluator::accumulatorFor(const ChessGame& game) {
+    const UndoStack& history = game.getHistory();
+    int ply = history.size();
+    if (int(accumulators.size()) <= ply) {
+        accumulators.resize(ply + 1);
+    }
+
+    int start = ply;
+    while (start >= 0 && ply - start <= NNUE_MAX_UPDATE_PLIES) {
+        uint64_t key = (start == ply) ? game.hash() : history[start].key;
+        if (accumulators[start].computed && accumulators[start].key == key) {
+            break;
+        }
+        --start;
+    }
+    if (start < 0 || ply - start > NNUE_MAX_UPDATE_PLIES) {
+        refresh(game, accumulators[ply]);
+        Color mover = Color(1 - game.getCurrentTurn());
+        for (int i = ply; i > 0 && ply - i < NNUE_MAX_UPDATE_PLIES; --i) {
+            update(accumulators[i], accumulators[i - 1], history[i - 1], mover, true);
+            accumulators[i - 1].key = history[i - 1].key;
+            mover = Color(1 - mover);
+        }
+        return accumulators[ply];
+    }
+
+    // The player to move alternates, so the mover of the move played from ply i follows from the current turn
+    Color mover = ((ply - start) % 2 == 0) ? game.getCurrentTurn() : Color(1 - game.getCurrentTurn());
+    for (int i = start; i < ply; ++i) {
+        update(accumulators[i], accumulators[i + 1], history[i], mover, false);
+        accumulators[i + 1].key = (i + 1 == ply) ? game.hash() : history[i + 1].key;
+        mover = Color(1 - mover);
+    }
+    return accumulators[ply];
+}
+
+// Method to compute an accumulator from the biases and the columns of all the pieces on the board
+void NnueEvaluator::refresh(const ChessGame& game, NnueAccumulator& accumulator) {
+    for (Color perspective : {WHITE, BLACK}) {
+        int16_t* values = accumulator.values[perspective];
+        memcpy(values, network.getFeatureBiases(), sizeof(accumulator.values[perspective]));
+        for (int piece = W_PAWN; piece < NO_PIECE; ++piece) {
+            Bitboard pieces = game.getPieces(colorOf(Piece(piece)), typeOf(Piece(piece)));
+            while (pieces) {
+                int square = popLsb(pieces);
+                applyColumn(values, network.featureColumn(featureIndex(perspective, Piece(piece), square)), false);
+            }
+        }
+    }
+    accumulator.key = game.hash();
+    accumulator.computed = true;
+    ++refreshes;
+}
+
+// Method to compute an accumulator from the one before a move, or from the one after it with 'takeBack'.
+// A move takes at most two pieces off squares and puts at most two on others: the moving piece (replaced by the
+// promotion piece), the captured piece and the rook of a castling move. Taking it back does the opposite.
+void NnueEvaluator::update(const NnueAccumulator& source, NnueAccumulator& target, const UndoInfo& undo, Color mover,
+                           bool takeBack) {
+    Piece removedPieces[2];
+    int removedSquares[2];
+    Piece addedPieces[2];
+    int addedSquares[2];
+    int removedCount = 0;
+    int addedCount = 0;
+
+    Color opponent = Color(1 - mover);
+    int from = undo.move.getFrom();
+    int to = undo.move.getTo();
+    removedPieces[removedCount] = makePiece(mover, undo.movedType);
+    removedSquares[removedCount++] = from;
+    addedPieces[addedCount] = makePiece(mover, undo.move.getType() == PROMOTION ? undo.move.getPromotion() : undo.movedType);
+    addedSquares[addedCount++] = to;
+    if (undo.move.getType() == EN_PASSANT) {
+        removedPieces[removedCount] = makePiece(opponent, PAWN);
+        removedSquares[removedCount++] = (mover == WHITE) ? to - 8 : to + 8;
+    } else if (undo.capturedType != PIECE_TYPE_NB) {
+        removedPieces[removedCount] = makePiece(opponent, undo.capturedType);
+        removedSquares[removedCount++] = to;
+    } else if (undo.move.getType() == CASTLING) {
+        removedPieces[removedCount] = makePiece(mover, ROOK);
+        removedSquares[removedCount++] = (to > from) ? from + 3 : from - 4;
+        addedPieces[addedCount] = makePiece(mover, ROOK);
+        addedSquares[addedCount++] = (to > from) ? from + 1 : from - 1;
+    }
+
+    for (Color perspective : {WHITE, BLACK}) {
+        int16_t* values = target.values[perspective];
+        memcpy(values, source.values[perspective], sizeof(target.values[perspective]));
+        for (int i = 0; i < removedCount; ++i) {
+            int feature = featureIndex(perspective, removedPieces[i], removedSquares[i]);
+            applyColumn(values, network.featureColumn(feature), !takeBack);
+        }
+        for (int i = 0; i < addedCount; ++i) {
+            int feature = featureIndex(perspective, addedPieces[i], addedSquares[i]);
+            applyColumn(values, network.featureColumn(feature), takeBack);
+        }
+    }
+    target.computed = true;
+    ++updates;
+}
+
+// Method to score a position: the clipped accumulators of the side to move and of the other side go through the
+// output weights, and the sum is scaled back to centipawns
+int NnueEvaluator::evaluate(const ChessGame& game) {
+    const NnueAccumulator& accumulator = accumulatorFor(game);
+    Color us = game.getCurrentTurn();
+    Color them = Color(1 - us);
+    int32_t output = network.getOutputBias()
+                   + clippedDot(accumulator.values[us], network.getOutputWeights())
+                   + clippedDot(accumulator.values[them], network.getOutputWeights() + NNUE_HIDDEN);
+    int score = int(int64_t(output) * NNUE_SCALE / (NNUE_QA * NNUE_QB));
+    return max(-NNUE_MAX_SCORE, min(score, NNUE_MAX_SCORE));
+}
+
+// Getter for the name of the evaluator
+const char* NnueEvaluator::getName() const {
+    return "nnue";
+}
+
+// Getter for the number of accumulators computed from all the pieces
+uint64_t NnueEvaluator::getRefreshes() const {
+    return refreshes;
+}
+
+// Getter for the number of accumulators computed from the one of a neighbouring ply
+uint64_t NnueEvaluator::getUpdates() const {
+    return updates;
+}
@@ -0,0 +1,134 @@
+// Nnue.h
+// This file defines NnueNetwork, the weights of an efficiently updatable neural network (NNUE) that scores positions,
+// and NnueEvaluator, the Evaluator that runs it.
+// The network has one input per color, type and square of a piece, seen from each side: from Black's side the board
+// is mirrored vertically and the colors are swapped, so both sides share one set of weights. The inputs of each side
+// feed NNUE_HIDDEN neurons, whose sums (the accumulator) are kept in 16-bit integers. A move only switches a few
+// inputs on or off, so the accumulator of a position is worked out from the one before the move by adding and
+// subtracting a few weight columns rather than from all the pieces. The output is a weighted sum of both sides'
+// accumulators clipped to [0, NNUE_QA], the side to move first, computed with AVX2 or SSE2 when the engine is built
+// for them (-mavx2; SSE2 is part of every x86-64 build) and with plain integer code otherwise.
+//
+// A network file holds, in little-endian order: the four bytes "NNUE", the format version and the number of hidden
+// neurons as 32-bit integers, the 16-bit feature weights (NNUE_HIDDEN per input, input by input), the 16-bit hidden
+// biases, the 16-bit output weights (side to move first) and the 32-bit output bias. Weights are quantized so that
+// the accumulator is scaled by NNUE_QA and the output weights by NNUE_QB.
+
+#ifndef NNUE_H
+#define NNUE_H
+
+#include "Bitboard.h"
+#include "Evaluator.h"
+#include "Piece.h"
+#include "UndoStack.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Number of inputs seen from each side: one per color, type and square of a piece
+const int NNUE_FEATURES = 2 * PIECE_TYPE_NB * SQUARE_NB;
+
+// Number of hidden neurons per side, a multiple of 16 so that the vector code needs no tail
+const int NNUE_HIDDEN = 256;
+
+// Quantization of the clipped accumulator and of the output weights, and centipawns of one unit of output
+const int NNUE_QA = 255;
+const int NNUE_QB = 64;
+const int NNUE_SCALE = 400;
+
+// Version of the network file format
+const uint32_t NNUE_VERSION = 1;
+
+// Bound on the scores of the network, far from the mate scores of the search
+const int NNUE_MAX_SCORE = 20000;
+
+// Number of moves an accumulator is updated through before refreshing it from the pieces costs less
+const int NNUE_MAX_UPDATE_PLIES = 8;
+
+static_assert(NNUE_HIDDEN % 16 == 0, "The hidden layer must fill whole vectors");
+
+// NnueWeights holds the quantized parameters of a network
+struct NnueWeights {
+    alignas(32) int16_t featureWeights[NNUE_FEATURES * NNUE_HIDDEN]; // Column of NNUE_HIDDEN weights per input
+    alignas(32) int16_t featureBiases[NNUE_HIDDEN];                  // Bias of each hidden neuron
+    alignas(32) int16_t outputWeights[2 * NNUE_HIDDEN];              // Side to move first, then the other side
+    int32_t outputBias;                                              // Scaled by NNUE_QA * NNUE_QB
+};
+
+// NnueNetwork class holding the weights of a network. It is never changed while positions are evaluated, so one
+// network can be shared by the evaluators of all the threads.
+class NnueNetwork {
+private:
+    unique_ptr<NnueWeights> weights; // The parameters, on the heap as they take close to 400 kB
+
+public:
+    // Constructor that gives a network with every weight at zero
+    NnueNetwork();
+
+    // Loads the weights from a network file. If the file cannot be read or is not a network of this shape,
+    // the network is left unchanged and false is returned.
+    bool load(const string& path);
+
+    // Writes the weights to a network file, returning false if it cannot be written
+    bool save(const string& path) const;
+
+    // Fills the weights with small pseudo-random values from the seed. Such a network plays no better than chance,
+    // but it costs as much to run as a trained one, which is what benchmarks need when no network file is at hand.
+    void randomize(uint64_t seed);
+
+    // Returns the column of NNUE_HIDDEN weights of an input
+    const int16_t* featureColumn(int feature) const { return weights->featureWeights + feature * NNUE_HIDDEN; }
+
+    // Getters for the hidden biases, the output weights and the output bias
+    const int16_t* getFeatureBiases() const { return weights->featureBiases; }
+    const int16_t* getOutputWeights() const { return weights->outputWeights; }
+    int32_t getOutputBias() const { return weights->outputBias; }
+};
+
+// NnueAccumulator holds the hidden sums of both sides for one position
+struct NnueAccumulator {
+    alignas(32) int16_t values[2][NNUE_HIDDEN]; // Indexed by the Color of the side the inputs are seen from
+    uint64_t key = 0;                           // Hash of the position the sums belong to
+    bool computed = false;                      // Whether the sums have been worked out at all
+};
+
+// NnueEvaluator class scoring positions with a network. It keeps the accumulator of each ply of the game it
+// evaluates, so that the accumulator of a position is updated from the one of an earlier ply when that one is known.
+// An evaluator keeps this state for one game at a time, so each thread needs an evaluator of its own.
+class NnueEvaluator : public Evaluator {
+private:
+    const NnueNetwork& network;              // The network, owned by the caller
+    vector<NnueAccumulator> accumulators;    // Accumulator of each ply since the game's state was loaded
+    uint64_t refreshes;                      // Number of accumulators computed from all the pieces
+    uint64_t updates;                        // Number of accumulators computed from the one of a neighbouring ply
+
+    // Returns the accumulator of the game's current position, computing it and those of the plies before it
+    // as needed
+    const NnueAccumulator& accumulatorFor(const ChessGame& game);
+
+    // Computes an accumulator from all the pieces of the game's current position
+    void refresh(const ChessGame& game, NnueAccumulator& accumulator);
+
+    // Computes 'target' from 'source' and the undo record of the move between them, played by 'mover'. The move
+    // leads from 'source' to 'target', or from 'target' to 'source' with 'takeBack'.
+    void update(const NnueAccumulator& source, NnueAccumulator& target, const UndoInfo& undo, Color mover, bool takeBack);
+
+public:
+    // Constructor that binds the evaluator to a network
+    explicit NnueEvaluator(const NnueNetwork& network);
+
+    // Returns the network's score of the game's position
+    int evaluate(const ChessGame& game) override;
+
+    // Returns "nnue"
+    const char* getName() const override;
+
+    // Getters for the number of accumulators computed from all the pieces and from the one of a neighbouring ply
+    uint64_t getRefreshes() const;
+    uint64_t getUpdates() const;
+};
+
+#endif // NNUE_H
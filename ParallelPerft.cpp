@@ -0,0 +1,133 @@
+// ParallelPerft.cpp
+#include "ParallelPerft.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// PerftTask is one subtree handed out to a thread: a root move and, when the tree is deep enough, a reply to it
+struct PerftTask {
+    int rootIndex;   // Index of the root move in the root move list
+    ChessMove reply; // Reply played after the root move, or the null move if the task covers the root move alone
+};
+
+// Constructor that sets the number of threads and the table
+ParallelPerft::ParallelPerft(int threads, PerftTable* table) : threadCount(1), table(table) {
+    setThreads(threads);
+}
+
+// Setter for the number of threads
+void ParallelPerft::setThreads(int threads) {
+    threadCount = (threads < 1) ? 1 : threads;
+}
+
+// Setter for the table shared by the threads
+void ParallelPerft::setTable(PerftTable* perftTable) {
+    table = perftTable;
+}
+
+// Helper function to count the leaf nodes of a subtree.
+// Like ChessGame::perft, the moves of the last ply are counted without being played.
+uint64_t ParallelPerft::count(ChessGame& game, int depth, PerftTable* table) {
+    if (depth == 0) {
+        return 1;
+    }
+
+    uint64_t nodes = 0;
+    uint64_t key = game.hash();
+    if (table != nullptr && depth > 1 && table->probe(key, depth, nodes)) {
+        return nodes;
+    }
+
+    MoveList moves;
+    game.generateLegalMoves(moves);
+    if (depth == 1) {
+        return moves.size();
+    }
+
+    for (const ChessMove& move : moves) {
+        game.makeMove(move);
+        nodes += count(game, depth - 1, table);
+        game.unmakeMove();
+    }
+
+    if (table != nullptr) {
+        table->store(key, depth, nodes);
+    }
+    return nodes;
+}
+
+// Method to count the perft nodes on all threads.
+// Splitting at the replies rather than at the root moves gives the threads about 30 times more tasks than root
+// moves, which keeps them all busy until the end even when a few root moves have much larger subtrees.
+uint64_t ParallelPerft::run(ChessGame& game, int depth, vector<pair<ChessMove, uint64_t>>* rootCounts) {
+    if (depth <= 0) {
+        return 1;
+    }
+
+    MoveList rootMoves;
+    game.generateLegalMoves(rootMoves);
+
+    vector<PerftTask> tasks;
+    for (int i = 0; i < rootMoves.size(); ++i) {
+        if (depth < 3) {
+            tasks.push_back({i, ChessMove()});
+            continue;
+        }
+        MoveList replies;
+        game.makeMove(rootMoves[i]);
+        game.generateLegalMoves(replies);
+        game.unmakeMove();
+        for (const ChessMove& reply : replies) {
+            tasks.push_back({i, reply});
+        }
+    }
+
+    // Each task's count is written by the one thread that ran it, so the counts need no synchronization
+    vector<uint64_t> taskNodes(tasks.size(), 0);
+    atomic<size_t> nextTask(0);
+    auto worker = [&](ChessGame& threadGame) {
+        for (size_t task = nextTask.fetch_add(1); task < tasks.size(); task = nextTask.fetch_add(1)) {
+            threadGame.makeMove(rootMoves[tasks[task].rootIndex]);
+            if (tasks[task].reply.isNull()) {
+                taskNodes[task] = count(threadGame, depth - 1, table);
+            } else {
+                threadGame.makeMove(tasks[task].reply);
+                taskNodes[task] = count(threadGame, depth - 2, table);
+                threadGame.unmakeMove();
+            }
+            threadGame.unmakeMove();
+        }
+    };
+
+    // The calling thread works on the game itself, and every other thread on its own game set to a snapshot of it.
+    // Counting only needs the position, not the moves that led to it.
+    int helperCount = min(threadCount, int(tasks.size())) - 1;
+    BoardState rootState = game.snapshot();
+    vector<unique_ptr<ChessGame>> games;
+    vector<thread> helpers;
+    for (int i = 0; i < helperCount; ++i) {
+        games.emplace_back(new ChessGame());
+        games.back()->restore(rootState);
+        helpers.emplace_back(worker, ref(*games.back()));
+    }
+    worker(game);
+    for (thread& helper : helpers) {
+        helper.join();
+    }
+
+    // Add up the counts of the tasks below each root move
+    vector<uint64_t> rootNodes(rootMoves.size(), 0);
+    for (size_t task = 0; task < tasks.size(); ++task) {
+        rootNodes[tasks[task].rootIndex] += taskNodes[task];
+    }
+
+    uint64_t nodes = 0;
+    for (int i = 0; i < rootMoves.size(); ++i) {
+        nodes += rootNodes[i];
+        if (rootCounts != nullptr) {
+            rootCounts->emplace_back(rootMoves[i], rootNodes[i]);
+        }
+    }
+    return nodes;
+}
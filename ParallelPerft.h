@@ -0,0 +1,43 @@
+// ParallelPerft.h
+// This file defines the ParallelPerft class, which counts the leaf nodes of the legal move tree (perft)
+// on several threads. The tree is split into the subtrees below each pair of a root move and a reply, which are
+// handed out to the threads one at a time, so that a thread finishing a small subtree early takes the next one.
+// Each thread plays its subtrees on its own copy of the game. An optional PerftTable shared by the threads
+// caches the counts of subtrees reached again through a different move order.
+
+#ifndef PARALLELPERFT_H
+#define PARALLELPERFT_H
+
+#include "ChessGame.h"
+#include "PerftTable.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// ParallelPerft class counting perft nodes with a configurable number of threads
+class ParallelPerft {
+private:
+    int threadCount;   // Number of threads
+    PerftTable* table; // Table shared by the threads, or nullptr
+
+    // Counts the leaf nodes 'depth' plies below the current position of the game, using the table if any
+    static uint64_t count(ChessGame& game, int depth, PerftTable* table);
+
+public:
+    // Constructor that sets the number of threads and the table, which the caller owns
+    ParallelPerft(int threads = 1, PerftTable* table = nullptr);
+
+    // Sets the number of threads, at least one
+    void setThreads(int threads);
+
+    // Sets the table shared by the threads, or nullptr for none
+    void setTable(PerftTable* perftTable);
+
+    // Counts the leaf nodes 'depth' plies below the current position of the game, which is left unchanged.
+    // When 'rootCounts' is not nullptr, each root move is appended to it together with the count below it.
+    uint64_t run(ChessGame& game, int depth, vector<pair<ChessMove, uint64_t>>* rootCounts = nullptr);
+};
+
+#endif // PARALLELPERFT_H
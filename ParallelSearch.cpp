@@ -0,0 +1,86 @@
+// ParallelSearch.cpp
+#include "ParallelSearch.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+
+// Constructor that binds the search to a game and a transposition table
+ParallelSearch::ParallelSearch(ChessGame& game, TranspositionTable& table, int threads)
+    : game(game), table(table), threadCount(1), infoCallback(nullptr), network(nullptr) {
+    setThreads(threads);
+}
+
+// Setter for the number of threads
+void ParallelSearch::setThreads(int threads) {
+    threadCount = (threads < 1) ? 1 : threads;
+}
+
+// Setter for the function called by the main thread after each completed iteration
+void ParallelSearch::setInfoCallback(SearchInfoCallback callback) {
+    infoCallback = callback;
+}
+
+// Setter for the network scoring the leaf positions
+void ParallelSearch::setNetwork(const NnueNetwork* nnueNetwork) {
+    network = nnueNetwork;
+}
+
+// Method to run the search on all threads.
+// The helper threads search without limits until the main thread, which enforces the limits, is done.
+// Every other helper searches one ply deeper than the main thread, so that the threads do not all
+// search the same tree in the same order.
+SearchResult ParallelSearch::run(const SearchLimits& limits) {
+    table.newSearch();
+
+    atomic<bool> stopHelpers(false);
+    vector<unique_ptr<ChessGame>> games;
+    vector<unique_ptr<Search>> searches;
+    vector<unique_ptr<NnueEvaluator>> evaluators;
+    for (int i = 1; i < threadCount; ++i) {
+        games.emplace_back(new ChessGame(game));
+        searches.emplace_back(new Search(*games.back(), table));
+        searches.back()->setDepthOffset(i % 2);
+        searches.back()->setStopSignal(&stopHelpers);
+        if (network != nullptr) {
+            evaluators.emplace_back(new NnueEvaluator(*network));
+            searches.back()->setEvaluator(evaluators.back().get());
+        }
+    }
+
+    // Start the helpers, then search with the main thread on the game itself
+    vector<SearchResult> helperResults(searches.size());
+    vector<thread> helpers;
+    for (size_t i = 0; i < searches.size(); ++i) {
+        helpers.emplace_back([&searches, &helperResults, &limits, i]() {
+            SearchLimits helperLimits;
+            helperLimits.depth = limits.depth;
+            helperResults[i] = searches[i]->run(helperLimits);
+        });
+    }
+
+    Search mainSearch(game, table);
+    mainSearch.setInfoCallback(infoCallback);
+    unique_ptr<NnueEvaluator> mainEvaluator;
+    if (network != nullptr) {
+        mainEvaluator.reset(new NnueEvaluator(*network));
+        mainSearch.setEvaluator(mainEvaluator.get());
+    }
+    SearchResult result = mainSearch.run(limits);
+
+    stopHelpers.store(true, memory_order_relaxed);
+    for (thread& helper : helpers) {
+        helper.join();
+    }
+
+    threadNodes.assign(1, result.nodes);
+    for (const SearchResult& helperResult : helperResults) {
+        threadNodes.push_back(helperResult.nodes);
+        result.nodes += helperResult.nodes;
+    }
+    return result;
+}
+
+// Getter for the number of nodes searched by each thread in the last search
+const vector<uint64_t>& ParallelSearch::getThreadNodes() const {
+    return threadNodes;
+}
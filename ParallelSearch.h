@@ -0,0 +1,53 @@
+// ParallelSearch.h
+// This file defines the ParallelSearch class, which runs the search on several threads at once (Lazy SMP).
+// Every thread searches the same position with its own copy of the game and its own Search, and all of them share
+// one transposition table. The threads do not divide the work explicitly: the results each one stores in the table
+// steer the move ordering and cutoffs of the others, so together they reach a given depth sooner than one thread.
+// The move played is the one found by the main thread. When a network is set, every thread scores its leaf positions
+// with an NnueEvaluator of its own, all of them sharing the network.
+
+#ifndef PARALLELSEARCH_H
+#define PARALLELSEARCH_H
+
+#include "ChessGame.h"
+#include "Nnue.h"
+#include "Search.h"
+#include "TranspositionTable.h"
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// ParallelSearch class searching a ChessGame position with a configurable number of threads
+class ParallelSearch {
+private:
+    ChessGame& game;                    // The game searched; each thread works on a copy of it
+    TranspositionTable& table;          // Table shared by all threads
+    int threadCount;                    // Number of threads, including the main one
+    SearchInfoCallback infoCallback;    // Called by the main thread after each iteration, or nullptr
+    const NnueNetwork* network;         // Network scoring the leaf positions, or nullptr for the static evaluation
+    vector<uint64_t> threadNodes;       // Number of nodes searched by each thread in the last search
+
+public:
+    // Constructor that binds the search to a game and a transposition table, searching with 'threads' threads
+    ParallelSearch(ChessGame& game, TranspositionTable& table, int threads = 1);
+
+    // Sets the number of threads, at least one
+    void setThreads(int threads);
+
+    // Sets the function called by the main thread after each completed iteration, or nullptr for none
+    void setInfoCallback(SearchInfoCallback callback);
+
+    // Sets the network scoring the leaf positions, or nullptr for the static evaluation. The network is owned by
+    // the caller.
+    void setNetwork(const NnueNetwork* nnueNetwork);
+
+    // Searches the current position of the game within the limits and returns the result of the main thread,
+    // with the node count of all threads together
+    SearchResult run(const SearchLimits& limits);
+
+    // Getter for the number of nodes searched by each thread in the last search, main thread first
+    const vector<uint64_t>& getThreadNodes() const;
+};
+
+#endif // PARALLELSEARCH_H
@@ -52,7 +52,7 @@ bool Pawn::isValidMove(const Position& from, const Position& to, const ChessGame
     // Check if the move is a valid capture (diagonal move)
     if (abs(from.getCol() - to.getCol()) == 1) { // Check if move exactly one column apart
         int rowDiff = to.getRow() - from.getRow();
-        ChessPiece* targetPiece = game.getPieceAt(to); // Get the piece at the target position
+        const ChessPiece* targetPiece = game.getPieceAt(to); // Get the piece at the target position
 
         // Check for white pawns (move diagonally upwards and capturing an opponent's piece)
         if (color == WHITE && rowDiff == -1 && targetPiece != nullptr && targetPiece->getColor() != color) {
@@ -62,6 +62,13 @@ bool Pawn::isValidMove(const Position& from, const Position& to, const ChessGame
         else if (color == BLACK && rowDiff == 1 && targetPiece != nullptr && targetPiece->getColor() != color) {
             return true;
         }
+
+        // Check for en passant: the pawn moves onto the square an opponent's pawn skipped over on the last move
+        int forward = (color == WHITE) ? -1 : 1;
+        if (rowDiff == forward && targetPiece == nullptr && color == game.getCurrentTurn()
+            && squareOf(to) == game.getEnPassantSquare()) {
+            return true;
+        }
     }
 
     // If none of the above conditions are met, the move is not valid for a pawn
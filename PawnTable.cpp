@@ -0,0 +1,48 @@
+// PawnTable.cpp
+#include "PawnTable.h"
+
+// Constructor that allocates the entries and empties them
+PawnTable::PawnTable() : entries(new PawnEntry[PAWN_TABLE_SIZE]) {
+    clear();
+}
+
+// Method to find the entry of a pawn skeleton.
+// A position without pawns has a pawn key of 0, which matches an empty slot holding no score and no passed pawn,
+// exactly what evaluating no pawns gives.
+const PawnEntry& PawnTable::probe(uint64_t pawnKey, Bitboard whitePawns, Bitboard blackPawns) {
+    PawnEntry& entry = entries[pawnKey & (PAWN_TABLE_SIZE - 1)];
+    if (entry.key == pawnKey) {
+        ++hits;
+        return entry;
+    }
+    ++misses;
+    entry.key = pawnKey;
+    entry.score = evaluatePawns(whitePawns, blackPawns, entry.passedPawns);
+    return entry;
+}
+
+// Getter for the number of probes that found their skeleton
+uint64_t PawnTable::getHits() const {
+    return hits;
+}
+
+// Getter for the number of probes that had to evaluate their skeleton
+uint64_t PawnTable::getMisses() const {
+    return misses;
+}
+
+// Method to empty the table
+void PawnTable::clear() {
+    for (size_t i = 0; i < PAWN_TABLE_SIZE; ++i) {
+        entries[i].key = 0;
+        entries[i].score = 0;
+        entries[i].passedPawns = 0;
+    }
+    hits = misses = 0;
+}
+
+// Method returning the calling thread's table
+PawnTable& PawnTable::forThread() {
+    thread_local PawnTable table;
+    return table;
+}
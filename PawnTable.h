@@ -0,0 +1,54 @@
+// PawnTable.h
+// This file defines the PawnTable class, a small hash table caching the pawn structure part of the evaluation.
+// That part only depends on where the pawns stand, which few moves change, so the same pawn skeleton comes back
+// at a large share of the positions a search evaluates. The table is keyed by the pawn key of the position, a
+// Zobrist hash of the pawns alone kept up to date by the moves.
+// Each thread evaluates with a table of its own, so the table needs no locks or atomics.
+
+#ifndef PAWNTABLE_H
+#define PAWNTABLE_H
+
+#include "Bitboard.h"
+#include "Evaluation.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+using namespace std;
+
+// Number of entries of a table, a power of two
+const size_t PAWN_TABLE_SIZE = 8192;
+
+// PawnEntry holds what the evaluation knows about one pawn skeleton
+struct PawnEntry {
+    uint64_t key;          // Pawn key of the skeleton
+    Score score;           // Pawn structure score from White's point of view
+    Bitboard passedPawns;  // Passed pawns of both colors
+};
+
+// PawnTable class caching pawn structure scores and passed pawns by pawn key
+class PawnTable {
+private:
+    unique_ptr<PawnEntry[]> entries; // Entry array, PAWN_TABLE_SIZE entries
+    uint64_t hits;                   // Number of probes that found their skeleton
+    uint64_t misses;                 // Number of probes that had to evaluate it
+
+public:
+    // Constructor that allocates an empty table
+    PawnTable();
+
+    // Returns the entry of a pawn skeleton, evaluating the pawns and replacing the slot's entry if it is not stored
+    const PawnEntry& probe(uint64_t pawnKey, Bitboard whitePawns, Bitboard blackPawns);
+
+    // Getters for the number of probes that found their skeleton and that did not
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+
+    // Empties the table and resets its counters
+    void clear();
+
+    // Returns the table of the calling thread, created on first use
+    static PawnTable& forThread();
+};
+
+#endif // PAWNTABLE_H
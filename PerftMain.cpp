@@ -0,0 +1,152 @@
+// PerftMain.cpp
+// Command-line perft tool. It counts the leaf nodes of the legal move tree of a position, which checks the move
+// rules against known reference counts and measures how fast moves are generated.
+//
+// Usage:
+//   perft [options]                          runs the bundled suite of reference positions
+//   perft "<fen>" <depth> [options]          counts the nodes of one position
+//   perft "<fen>" <depth> divide [options]   also prints the node count below each root move
+//
+// Options:
+//   threads <count>   splits the tree across the given number of threads
+//   hash <MB>         caches subtree counts in a table of the given size shared by the threads
+
+#include "ChessGame.h"
+#include "ParallelPerft.h"
+#include "PerftTable.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using std::cout;
+
+// A reference position together with its known node count at a given depth
+struct PerftCase {
+	const char* name;
+	const char* fen;
+	int depth;
+	uint64_t nodes;
+};
+
+// Reference positions and node counts from the chess programming community.
+// Between them they exercise castling, en passant (including the discovered check along the rank it can open)
+// and every promotion piece.
+static const PerftCase suite[] = {
+	{"Start position", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq -", 4, 197281},
+	{"Kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -", 4, 4085603},
+	{"Position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - -", 5, 674624},
+	{"Position 4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq -", 4, 422333},
+	{"Position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 2103487},
+	{"Position 6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - -", 4, 3894594},
+};
+
+// Runs perft on the loaded position and prints the node count, the time taken and the speed in nodes per second.
+// When 'divide' is true, the count below each root move is printed first.
+static uint64_t runPerft(ChessGame& game, ParallelPerft& perft, int depth, bool divide) {
+	std::vector<std::pair<ChessMove, uint64_t>> rootCounts;
+	auto start = std::chrono::steady_clock::now();
+	uint64_t nodes = perft.run(game, depth, divide ? &rootCounts : nullptr);
+	auto end = std::chrono::steady_clock::now();
+
+	for (const auto& rootCount : rootCounts) {
+		cout << rootCount.first.toString() << ": " << rootCount.second << '\n';
+	}
+	double seconds = std::chrono::duration<double>(end - start).count();
+	cout << "Nodes: " << nodes << "  Time: " << uint64_t(seconds * 1000) << " ms"
+	     << "  NPS: " << (seconds > 0 ? uint64_t(nodes / seconds) : 0) << '\n';
+	return nodes;
+}
+
+// Helper function to print how the tool is used
+static void printUsage() {
+	cout << "Usage: perft [threads <count>] [hash <MB>]\n";
+	cout << "       perft \"<fen>\" <depth> [divide] [threads <count>] [hash <MB>]\n";
+}
+
+// Helper function to read a whole argument as a decimal number, returning false if it is anything else
+static bool parseNumber(const char* text, uint64_t& value) {
+	if (*text < '0' || *text > '9') {
+		return false;
+	}
+	char* end;
+	errno = 0;
+	value = std::strtoull(text, &end, 10);
+	return *end == '\0' && errno == 0;
+}
+
+int main(int argc, char* argv[]) {
+	// Leading positional arguments are the FEN, the depth and "divide"; the options follow them
+	int positional = 1;
+	while (positional < argc && positional < 4) {
+		std::string arg = argv[positional];
+		if (arg == "threads" || arg == "hash") {
+			break;
+		}
+		++positional;
+	}
+	// Either no positional argument (the suite), or the FEN and the depth, optionally followed by "divide"
+	uint64_t depth = 0;
+	bool divide = (positional == 4);
+	if (positional == 2 || (positional >= 3 && (!parseNumber(argv[2], depth) || depth == 0 || depth > uint64_t(MAX_PLY)))
+	    || (divide && std::string(argv[3]) != "divide")) {
+		printUsage();
+		return 1;
+	}
+
+	uint64_t threads = 1;
+	uint64_t hashMegabytes = 0;
+	for (int i = positional; i < argc; i += 2) {
+		std::string option = argv[i];
+		bool valid = false;
+		if (i + 1 < argc && option == "threads") {
+			valid = parseNumber(argv[i + 1], threads) && threads > 0 && threads <= 1024;
+		} else if (i + 1 < argc && option == "hash") {
+			valid = parseNumber(argv[i + 1], hashMegabytes);
+		}
+		if (!valid) {
+			printUsage();
+			return 1;
+		}
+	}
+
+	std::unique_ptr<PerftTable> table;
+	if (hashMegabytes > 0) {
+		table.reset(new PerftTable(hashMegabytes));
+	}
+	ParallelPerft perft(int(threads), table.get());
+	ChessGame game;
+
+	// Single position mode
+	if (positional >= 3) {
+		FenResult fen = game.setState(argv[1]);
+		if (!fen.ok()) {
+			cout << fenErrorMessage(fen.error) << '\n';
+			return 1;
+		}
+		runPerft(game, perft, int(depth), divide);
+		return 0;
+	}
+
+	// Suite mode: every reference position must reproduce its known node count
+	int failures = 0;
+	for (const PerftCase& test : suite) {
+		cout << test.name << " (depth " << test.depth << ")\n";
+		game.loadState(test.fen);
+		uint64_t nodes = runPerft(game, perft, test.depth, false);
+		if (nodes == test.nodes) {
+			cout << "PASS\n\n";
+		} else {
+			cout << "FAIL: expected " << test.nodes << "\n\n";
+			++failures;
+		}
+	}
+
+	cout << (failures == 0 ? "All positions passed" : "Some positions failed") << '\n';
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+// PerftTable.cpp
+#include "PerftTable.h"
+
+// Constructor that allocates a table using at most 'megabytes' of memory.
+// The entry count is the largest power of two that fits the budget, with at least one entry.
+PerftTable::PerftTable(size_t megabytes) {
+    size_t budget = megabytes * 1024 * 1024 / sizeof(PerftEntry);
+    entryCount = 1;
+    while (entryCount * 2 <= budget) {
+        entryCount *= 2;
+    }
+
+    entries = new PerftEntry[entryCount];
+    for (size_t i = 0; i < entryCount; ++i) {
+        entries[i].check.store(0, memory_order_relaxed);
+        entries[i].data.store(0, memory_order_relaxed);
+    }
+}
+
+// Destructor that releases the entry array
+PerftTable::~PerftTable() {
+    delete[] entries;
+}
+
+// Method to look up the node count of a position at the given depth
+bool PerftTable::probe(uint64_t key, int depth, uint64_t& nodes) const {
+    const PerftEntry& entry = entries[key & (entryCount - 1)];
+    uint64_t data = entry.data.load(memory_order_relaxed);
+    if ((entry.check.load(memory_order_relaxed) ^ data) == key && int(data >> 56) == depth) {
+        nodes = data & ((uint64_t(1) << 56) - 1);
+        return true;
+    }
+    return false;
+}
+
+// Method to store the node count of a position at the given depth
+void PerftTable::store(uint64_t key, int depth, uint64_t nodes) {
+    PerftEntry& entry = entries[key & (entryCount - 1)];
+    uint64_t data = nodes | (uint64_t(depth) << 56);
+    entry.check.store(key ^ data, memory_order_relaxed);
+    entry.data.store(data, memory_order_relaxed);
+}
@@ -0,0 +1,48 @@
+// PerftTable.h
+// This file defines the PerftTable class, a hash table caching the node counts of perft subtrees.
+// Perft visits the same position many times through different move orders, and the subtree below a position
+// has the same node count each time, so it is counted once and looked up afterwards. The table is keyed by the
+// Zobrist hash of the position together with the remaining depth.
+// Several threads may use one table at the same time without locks: each entry stores its key XORed with its data,
+// so an entry torn by two simultaneous writes no longer matches its key and reads as a miss.
+
+#ifndef PERFTTABLE_H
+#define PERFTTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// PerftEntry is one slot of the table
+struct PerftEntry {
+    atomic<uint64_t> check; // Zobrist hash of the position XORed with the data, 0 for an empty slot
+    atomic<uint64_t> data;  // Node count in bits 0-55 and remaining depth in bits 56-63
+};
+
+// PerftTable class caching subtree node counts under a fixed memory budget
+class PerftTable {
+private:
+    PerftEntry* entries; // Entry array
+    size_t entryCount;   // Number of entries, always a power of two
+
+public:
+    // Constructor that allocates a table using at most 'megabytes' of memory
+    PerftTable(size_t megabytes);
+
+    // Destructor that releases the entry array
+    ~PerftTable();
+
+    // The table owns its memory and is shared by pointer, so it cannot be copied
+    PerftTable(const PerftTable&) = delete;
+    PerftTable& operator=(const PerftTable&) = delete;
+
+    // Looks up the node count of a position at the given depth. Returns true and fills 'nodes' if it is stored.
+    bool probe(uint64_t key, int depth, uint64_t& nodes) const;
+
+    // Stores the node count of a position at the given depth, replacing whatever the slot held
+    void store(uint64_t key, int depth, uint64_t nodes);
+};
+
+#endif // PERFTTABLE_H
@@ -0,0 +1,132 @@
+// PgnMain.cpp
+// Command-line PGN checker. It streams the games of a PGN archive, replays every move on the board and prints
+// the games whose moves cannot be resolved, followed by a summary.
+//
+// Usage:
+//   pgn <file>
+//   pgn check      reads a small archive of awkwardly written games and checks how they are split and replayed
+
+#include "ChessGame.h"
+#include "PgnReader.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+using std::cout;
+using std::string;
+
+// The archive read by "pgn check": a game with tags but no movetext, a ";" comment inside a variation that holds
+// a closing parenthesis, a "{...}" comment with a line starting with '[', and standalone annotations
+static const char* const CheckArchive =
+	"[Event \"Tags only\"]\n"
+	"[White \"First\"]\n"
+	"\n"
+	"[Event \"Line comment in a variation\"]\n"
+	"[White \"Second\"]\n"
+	"\n"
+	"1. e4 (1. d4 ; the reply ) is not played\n"
+	"d5) 1... e5 2. Nf3 *\n"
+	"\n"
+	"[Event \"Bracket in a comment\"]\n"
+	"[White \"Third\"]\n"
+	"\n"
+	"1. e4 {a comment\n"
+	"[starting a line with a bracket]} e5 !? 2. Nf3 1-0\n";
+
+// Expected split and replay of each game of CheckArchive
+struct PgnCheck {
+	const char* white; // Value of the White tag
+	int plies;         // Number of moves played
+};
+static const PgnCheck Checks[] = {{"First", 0}, {"Second", 3}, {"Third", 3}};
+
+// Writes CheckArchive to a temporary file, reads it back and checks every game. Returns the number of failures.
+static int runChecks() {
+	char path[] = "/tmp/pgn-check-XXXXXX";
+	int descriptor = mkstemp(path);
+	if (descriptor < 0) {
+		cout << "Cannot create a temporary file\n";
+		return 1;
+	}
+	string archive = CheckArchive;
+	bool written = (write(descriptor, archive.data(), archive.size()) == ssize_t(archive.size()));
+	::close(descriptor);
+
+	int failures = 0;
+	PgnReader reader;
+	if (written && reader.open(path)) {
+		ChessGame board;
+		PgnGame game;
+		size_t count = 0;
+		while (reader.nextGame(game)) {
+			std::string_view failedMove;
+			int played = PgnReader::playGame(game, board, &failedMove);
+			bool passed = count < sizeof(Checks) / sizeof(Checks[0]) && game.tag("White") == Checks[count].white
+			              && played == Checks[count].plies && failedMove.empty();
+			cout << "Game " << count + 1 << " (" << game.tag("Event") << "): " << (passed ? "PASS" : "FAIL") << '\n';
+			failures += passed ? 0 : 1;
+			++count;
+		}
+		bool passed = (count == sizeof(Checks) / sizeof(Checks[0]));
+		cout << "Number of games: " << (passed ? "PASS" : "FAIL") << '\n';
+		failures += passed ? 0 : 1;
+	} else {
+		cout << "Cannot write and read back " << path << '\n';
+		++failures;
+	}
+	reader.close();
+	std::remove(path);
+
+	cout << (failures == 0 ? "All checks passed" : "Some checks failed") << '\n';
+	return failures;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc == 2 && string(argv[1]) == "check") {
+		return runChecks() == 0 ? 0 : 1;
+	}
+	if (argc < 2) {
+		cout << "Usage: pgn <file>\n";
+		cout << "       pgn check\n";
+		return 1;
+	}
+
+	PgnReader reader;
+	if (!reader.open(argv[1])) {
+		cout << "Cannot open " << argv[1] << '\n';
+		return 1;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	ChessGame board;
+	PgnGame game;
+	uint64_t games = 0;
+	uint64_t plies = 0;
+	uint64_t failures = 0;
+	while (reader.nextGame(game)) {
+		++games;
+		std::string_view failedMove;
+		int played = PgnReader::playGame(game, board, &failedMove);
+		if (played < 0) {
+			++failures;
+			cout << "Game " << games << ": invalid FEN\n";
+			continue;
+		}
+		plies += played;
+		if (!failedMove.empty()) {
+			++failures;
+			cout << "Game " << games << ": cannot play move " << played + 1 << " (" << failedMove << ")\n";
+		}
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	double seconds = std::chrono::duration<double>(end - start).count();
+	cout << "Games: " << games << "  Moves: " << plies << "  Failed: " << failures
+	     << "  Time: " << uint64_t(seconds * 1000) << " ms"
+	     << "  MB/s: " << (seconds > 0 ? reader.getOffset() / seconds / (1024 * 1024) : 0) << '\n';
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,312 @@
+// PgnReader.cpp
+#include "PgnReader.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Helper function to check if a character separates tokens in the movetext
+static bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+// Method to find the value of a tag by name
+string_view PgnGame::tag(string_view name) const {
+    for (const PgnTag& pair : tags) {
+        if (pair.name == name) {
+            return pair.value;
+        }
+    }
+    return string_view();
+}
+
+// Constructor that creates a reader with no file open
+PgnReader::PgnReader() : fileDescriptor(-1), data(nullptr), size(0), offset(0) {
+}
+
+// Destructor that unmaps and closes the file
+PgnReader::~PgnReader() {
+    close();
+}
+
+// Method to open and map a PGN file.
+// The kernel is told the file is read sequentially, so it reads ahead and drops pages already read.
+bool PgnReader::open(const string& path) {
+    close();
+    fileDescriptor = ::open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fileDescriptor, &info) != 0) {
+        close();
+        return false;
+    }
+    size = size_t(info.st_size);
+    if (size > 0) {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if (mapping == MAP_FAILED) {
+            close();
+            return false;
+        }
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(mapping);
+    }
+    return true;
+}
+
+// Method to unmap and close the file
+void PgnReader::close() {
+    if (data != nullptr) {
+        munmap(const_cast<char*>(data), size);
+    }
+    if (fileDescriptor >= 0) {
+        ::close(fileDescriptor);
+    }
+    fileDescriptor = -1;
+    data = nullptr;
+    size = offset = 0;
+}
+
+// Method to read the next game.
+// A game is a block of tag lines starting with '[' followed by its movetext, which runs up to the next line
+// starting with '[' outside a comment, or the end of the file. A game without movetext ends at the empty line
+// after its tags.
+bool PgnReader::nextGame(PgnGame& game) {
+    game.tags.clear();
+    game.movetext = string_view();
+
+    while (offset < size) {
+        // Skip the blank lines before the tags or the movetext, counting the line breaks
+        int lineBreaks = 0;
+        while (offset < size && isSpace(data[offset])) {
+            lineBreaks += (data[offset] == '\n');
+            ++offset;
+        }
+        if (offset >= size) {
+            break;
+        }
+
+        if (data[offset] == '[') {
+            // A tag line after an empty line ends a game that has tags but no movetext
+            if (!game.tags.empty() && lineBreaks > 1) {
+                return true;
+            }
+            // Tag line: [Name "Value"]
+            const char* lineEnd = static_cast<const char*>(memchr(data + offset, '\n', size - offset));
+            size_t end = (lineEnd != nullptr) ? size_t(lineEnd - data) : size;
+            string_view line(data + offset + 1, end - offset - 1);
+            size_t nameEnd = line.find_first_of(" \t\"]");
+            size_t valueStart = line.find('"');
+            size_t valueEnd = line.rfind('"');
+            if (nameEnd != string_view::npos && valueStart != string_view::npos && valueEnd > valueStart) {
+                game.tags.push_back({line.substr(0, nameEnd), line.substr(valueStart + 1, valueEnd - valueStart - 1)});
+            }
+            offset = end;
+            continue;
+        }
+
+        // Movetext: up to the next tag line. A line starting with '[' inside a "{...}" comment belongs to the
+        // comment, and a '{' inside a ";" comment opens nothing.
+        size_t start = offset;
+        size_t end = size;
+        bool inBraceComment = false;
+        bool inLineComment = false;
+        for (size_t i = offset; i < size; ++i) {
+            char c = data[i];
+            if (inBraceComment) {
+                inBraceComment = (c != '}');
+            } else if (c == '\n') {
+                inLineComment = false;
+                if (i + 1 < size && data[i + 1] == '[') {
+                    end = i;
+                    break;
+                }
+            } else if (!inLineComment) {
+                inBraceComment = (c == '{');
+                inLineComment = (c == ';');
+            }
+        }
+        offset = end;
+        while (end > start && isSpace(data[end - 1])) {
+            --end;
+        }
+        game.movetext = string_view(data + start, end - start);
+        return true;
+    }
+    return !game.tags.empty();
+}
+
+// Getter for the number of bytes read so far
+size_t PgnReader::getOffset() const {
+    return offset;
+}
+
+// Method to set up a game and play its moves.
+// Comments ("{...}" and ";" to the end of the line), variations ("(...)", which may nest), numeric annotation
+// glyphs ("$1"), standalone annotations ("!?", "e.p.") and move numbers ("12." or "12...") are skipped, and the
+// result ends the game.
+int PgnReader::playGame(const PgnGame& game, ChessGame& board, string_view* failedMove) {
+    string_view fen = game.tag("FEN");
+    bool loaded = board.setState(fen.empty() ? string_view(START_FEN) : fen).ok();
+    if (!loaded) {
+        return -1;
+    }
+
+    string_view text = game.movetext;
+    int plies = 0;
+    size_t i = 0;
+    while (i < text.size()) {
+        char c = text[i];
+        if (isSpace(c)) {
+            ++i;
+        } else if (c == '{') {
+            size_t close = text.find('}', i);
+            i = (close == string_view::npos) ? text.size() : close + 1;
+        } else if (c == ';') {
+            size_t close = text.find('\n', i);
+            i = (close == string_view::npos) ? text.size() : close + 1;
+        } else if (c == '(') {
+            int level = 0;
+            for (; i < text.size(); ++i) {
+                if (text[i] == '{') {
+                    size_t close = text.find('}', i);
+                    i = (close == string_view::npos) ? text.size() - 1 : close;
+                } else if (text[i] == ';') {
+                    size_t close = text.find('\n', i);
+                    i = (close == string_view::npos) ? text.size() - 1 : close;
+                } else if (text[i] == '(') {
+                    ++level;
+                } else if (text[i] == ')' && --level == 0) {
+                    ++i;
+                    break;
+                }
+            }
+        } else if (c == '$' || c == ')') {
+            // Numeric annotation glyph, or a stray closing parenthesis
+            ++i;
+            while (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+                ++i;
+            }
+        } else {
+            size_t end = i;
+            while (end < text.size() && !isSpace(text[end]) && text[end] != '{' && text[end] != ';' && text[end] != '(') {
+                ++end;
+            }
+            string_view token = text.substr(i, end - i);
+            i = end;
+
+            if (token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*") {
+                break;
+            }
+
+            // Strip a move number, which may be glued to the move ("1.e4")
+            size_t dots = token.find('.');
+            if (dots != string_view::npos && token.find_first_not_of("0123456789") == dots) {
+                token.remove_prefix(dots);
+                while (!token.empty() && token[0] == '.') {
+                    token.remove_prefix(1);
+                }
+            }
+            // Standalone annotations: "!", "?!" and the like, and "e.p." after an en passant capture
+            if (token.empty() || token.find_first_not_of("!?") == string_view::npos || token == "e.p.") {
+                continue;
+            }
+
+            ChessMove move = resolveSan(board, token);
+            if (move.isNull()) {
+                if (failedMove != nullptr) {
+                    *failedMove = token;
+                }
+                return plies;
+            }
+            board.makeMove(move);
+            ++plies;
+        }
+    }
+    return plies;
+}
+
+// Method to resolve a SAN token against the legal moves of the position.
+// A token is an optional piece letter, optional source file and rank, an optional 'x', the destination square
+// and, for pawns reaching the last rank, the promotion piece ("e8=Q" or "e8Q"). Castling is "O-O" or "O-O-O".
+ChessMove PgnReader::resolveSan(const ChessGame& board, string_view san) {
+    while (!san.empty() && string_view("+#!?").find(san.back()) != string_view::npos) {
+        san.remove_suffix(1);
+    }
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+
+    // Castling, also written with zeros
+    if (san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0") {
+        bool isKingSide = (san.size() == 3);
+        for (const ChessMove& move : moves) {
+            if (move.getType() == CASTLING && (move.getTo() > move.getFrom()) == isKingSide) {
+                return move;
+            }
+        }
+        return ChessMove();
+    }
+
+    // Piece letters in PieceType order, starting at KNIGHT
+    const string_view pieceLetters = "NBRQK";
+
+    PieceType type = PAWN;
+    if (!san.empty() && pieceLetters.find(san[0]) != string_view::npos) {
+        type = PieceType(KNIGHT + pieceLetters.find(san[0]));
+        san.remove_prefix(1);
+    }
+
+    PieceType promotion = PIECE_TYPE_NB;
+    if (type == PAWN && san.size() >= 3 && string_view("NBRQ").find(san.back()) != string_view::npos) {
+        promotion = PieceType(KNIGHT + pieceLetters.find(san.back()));
+        san.remove_suffix(1);
+        if (san.back() == '=') {
+            san.remove_suffix(1);
+        }
+    }
+
+    if (san.size() < 2) {
+        return ChessMove();
+    }
+    char toFile = san[san.size() - 2];
+    char toRank = san[san.size() - 1];
+    if (toFile < 'a' || toFile > 'h' || toRank < '1' || toRank > '8') {
+        return ChessMove();
+    }
+    int to = (toRank - '1') * 8 + (toFile - 'a');
+
+    // Whatever stands between the piece letter and the destination narrows down the source square
+    int fromFile = -1;
+    int fromRank = -1;
+    for (char c : san.substr(0, san.size() - 2)) {
+        if (c >= 'a' && c <= 'h') {
+            fromFile = c - 'a';
+        } else if (c >= '1' && c <= '8') {
+            fromRank = c - '1';
+        } else if (c != 'x' && c != '-' && c != ':') {
+            return ChessMove();
+        }
+    }
+
+    ChessMove found;
+    for (const ChessMove& move : moves) {
+        int from = move.getFrom();
+        if (move.getTo() != to || move.getType() == CASTLING || board.pieceTypeOn(from) != type
+            || (fromFile >= 0 && fileOf(from) != fromFile) || (fromRank >= 0 && rankOf(from) != fromRank)) {
+            continue;
+        }
+        PieceType movePromotion = (move.getType() == PROMOTION) ? move.getPromotion() : PIECE_TYPE_NB;
+        if (movePromotion != promotion) {
+            continue;
+        }
+        if (!found.isNull()) {
+            return ChessMove(); // Ambiguous
+        }
+        found = move;
+    }
+    return found;
+}
@@ -0,0 +1,77 @@
+// PgnReader.h
+// This file defines the PgnReader class, which reads games from a PGN (Portable Game Notation) archive.
+// The file is memory-mapped and read front to back, and every game is handed out as views into the mapping,
+// so that archives of any size are read in constant memory without copying their text.
+// The moves of a game are written in SAN (Standard Algebraic Notation, e.g., "Nbd7", "exd5", "O-O", "e8=Q+"),
+// which only makes sense in its position; resolveSan finds the legal move of a ChessGame a SAN token stands for.
+
+#ifndef PGNREADER_H
+#define PGNREADER_H
+
+#include "ChessGame.h"
+#include "ChessMove.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// PgnTag is one tag pair of a game header, e.g., [White "Carlsen, Magnus"]
+struct PgnTag {
+    string_view name;  // Tag name, e.g., "White"
+    string_view value; // Tag value without the quotes
+};
+
+// PgnGame holds one game of the archive as views into the mapped file, valid until the reader is closed
+struct PgnGame {
+    vector<PgnTag> tags;  // Tag pairs in file order
+    string_view movetext; // Moves, comments, variations and result
+
+    // Returns the value of a tag, or an empty view if the game does not have it
+    string_view tag(string_view name) const;
+};
+
+// PgnReader class reading the games of a PGN file one at a time
+class PgnReader {
+private:
+    int fileDescriptor; // Descriptor of the open file, or -1
+    const char* data;   // Start of the mapped file
+    size_t size;        // Size of the file in bytes
+    size_t offset;      // Position of the next unread byte
+
+public:
+    // Constructor that creates a reader with no file open
+    PgnReader();
+
+    // Destructor that unmaps and closes the file
+    ~PgnReader();
+
+    // The reader owns the mapping, so it cannot be copied
+    PgnReader(const PgnReader&) = delete;
+    PgnReader& operator=(const PgnReader&) = delete;
+
+    // Opens and maps a PGN file. Returns false if it cannot be read.
+    bool open(const string& path);
+
+    // Unmaps and closes the file; the views of the games read so far become invalid
+    void close();
+
+    // Reads the next game into 'game', reusing its storage. Returns false at the end of the file.
+    bool nextGame(PgnGame& game);
+
+    // Getter for the number of bytes read so far
+    size_t getOffset() const;
+
+    // Sets up the starting position of a game (its FEN tag, or the standard starting position) and plays its
+    // moves on 'board'. Returns the number of moves played; if a move cannot be resolved, its text is stored in
+    // 'failedMove' (when not nullptr) and the moves before it remain played. Returns -1 if the FEN is invalid.
+    static int playGame(const PgnGame& game, ChessGame& board, string_view* failedMove = nullptr);
+
+    // Finds the legal move of the player to move that a SAN token stands for.
+    // Check and annotation suffixes ("+", "#", "!", "?") are ignored. Returns the null move if no legal move,
+    // or more than one, matches the token.
+    static ChessMove resolveSan(const ChessGame& board, string_view san);
+};
+
+#endif // PGNREADER_H
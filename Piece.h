@@ -0,0 +1,35 @@
+// Piece.h
+// This file defines Piece, the one-byte code the board stores for each square.
+// A piece code combines a color and a type the same way pieceIndex does, so it can index the piece bitboards
+// and any table kept per color and type directly. NO_PIECE marks an empty square.
+
+#ifndef PIECE_H
+#define PIECE_H
+
+#include "Bitboard.h"
+#include "Color.h"
+#include <cstdint>
+
+// Defining Piece enumeration, one value per color and type, in the order of pieceIndex
+enum Piece : uint8_t {
+    W_PAWN, W_KNIGHT, W_BISHOP, W_ROOK, W_QUEEN, W_KING,
+    B_PAWN, B_KNIGHT, B_BISHOP, B_ROOK, B_QUEEN, B_KING,
+    NO_PIECE // Code of an empty square
+};
+
+// Returns the code of the piece of the given color and type
+inline Piece makePiece(Color color, PieceType type) {
+    return Piece(pieceIndex(color, type));
+}
+
+// Returns the color of a piece; the piece must not be NO_PIECE
+inline Color colorOf(Piece piece) {
+    return Color(piece >= B_PAWN);
+}
+
+// Returns the type of a piece, or PIECE_TYPE_NB for NO_PIECE
+inline PieceType typeOf(Piece piece) {
+    return (piece == NO_PIECE) ? PIECE_TYPE_NB : PieceType(piece % PIECE_TYPE_NB);
+}
+
+#endif // PIECE_H
@@ -29,4 +29,4 @@ bool Queen::isValidMove(const Position& from, const Position& to, const ChessGam
 
     // A valid queen move is either along the same row, the same column, or diagonally
     return (rowDifference == colDifference || to.getRow() == from.getRow() || to.getCol() == from.getCol());
-}
\ No newline at end of file
+}
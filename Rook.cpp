@@ -3,7 +3,7 @@
 #include "ChessGame.h"
 
 // Constructor that sets the color of the rook
-Rook::Rook(Color pieceColor) : ChessPiece(pieceColor), hasMoved(false){
+Rook::Rook(Color pieceColor) : ChessPiece(pieceColor){
 }
 
 // Destructor, ensures proper cleanup for Rook objects
@@ -26,13 +26,3 @@ bool Rook::isValidMove(const Position& from, const Position& to, const ChessGame
     // A rook can move either along the same row or the same column
     return (to.getRow() == from.getRow() || to.getCol() == from.getCol());
 } 
-
-// Method to set the moved status of the rook
-void Rook::setMoved() {
-    hasMoved = true;
-}
-
-// Method to check if the rook has moved before
-bool Rook::hasMovedBefore() const {
-    return hasMoved;
-}
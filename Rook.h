@@ -9,8 +9,6 @@
 #include "Color.h"
 
 class Rook : public ChessPiece {
-private:
-    bool hasMoved; // Flag to indicate if the rook has moved before --> for "Castling"
 public:
     // Constructor that sets the color of the rook
     Rook(Color pieceColor);
@@ -26,12 +24,6 @@ public:
 
     // Implementation of the pure virtual function to check if a move is valid for the knight
     bool isValidMove(const Position& from, const Position& to, const ChessGame& game) const override;
-
-    // Marks the rook as having moved, which is used to invalidate castling opportunities.
-    void setMoved();
-
-    // Flag to indicate if the rook has moved before, used for validating castling conditions.
-    bool hasMovedBefore() const;
 };
 
 #endif // ROOK_H
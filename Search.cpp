@@ -0,0 +1,352 @@
+// Search.cpp
+#include "Search.h"
+#include <algorithm>
+#include <cstring>
+
+// Material value of each piece type in centipawns, indexed by PieceType, used to order captures
+static const int PieceValues[PIECE_TYPE_NB] = {100, 320, 330, 500, 900, 0};
+
+// Ordering scores of the move classes; within a class, moves are ordered by MVV-LVA or by history
+static const int TT_MOVE_SCORE = 1 << 30;
+static const int CAPTURE_SCORE = 1 << 28;
+static const int KILLER_SCORE = 1 << 27;
+
+// Number of nodes searched between two checks of the limits
+static const uint64_t CHECK_INTERVAL = 2048;
+
+// Mate scores are stored relative to the position rather than the root, so that an entry reached through a different
+// path still tells the right distance to mate. These helpers convert between the two.
+static int scoreToTable(int score, int ply) {
+    if (score >= MATE_BOUND) return score + ply;
+    if (score <= -MATE_BOUND) return score - ply;
+    return score;
+}
+static int scoreFromTable(int score, int ply) {
+    if (score >= MATE_BOUND) return score - ply;
+    if (score <= -MATE_BOUND) return score + ply;
+    return score;
+}
+
+// Constructor that binds the search to a game and a transposition table
+Search::Search(ChessGame& game, TranspositionTable& table)
+    : game(game), table(table), infoCallback(nullptr), depthOffset(0), stopSignal(nullptr), evaluator(nullptr), nodes(0), stopped(false) {
+}
+
+// Setter for the function called after each completed iteration
+void Search::setInfoCallback(SearchInfoCallback callback) {
+    infoCallback = callback;
+}
+
+// Setter for the number of plies added to the depth of every iteration
+void Search::setDepthOffset(int offset) {
+    depthOffset = offset;
+}
+
+// Setter for the flag that stops the search
+void Search::setStopSignal(const atomic<bool>* signal) {
+    stopSignal = signal;
+}
+
+// Setter for the evaluator scoring the leaf positions
+void Search::setEvaluator(Evaluator* leafEvaluator) {
+    evaluator = leafEvaluator;
+}
+
+// Method to search the current position with iterative deepening.
+// Each iteration searches one ply deeper than the last; the result of the deepest completed iteration is returned,
+// since an iteration cut short by a limit may not have looked at the best move yet.
+SearchResult Search::run(const SearchLimits& searchLimits) {
+    limits = searchLimits;
+    startTime = chrono::steady_clock::now();
+    nodes = 0;
+    stopped = false;
+    memset(killers, 0, sizeof(killers));
+    memset(history, 0, sizeof(history));
+
+    SearchResult result;
+    MoveList rootMoves;
+    game.generateLegalMoves(rootMoves);
+    if (rootMoves.empty()) {
+        result.score = game.isKingInCheck(game.getCurrentTurn()) ? -MATE_SCORE : 0;
+        return result;
+    }
+    result.bestMove = rootMoves[0]; // Something to play even if the first iteration does not complete
+
+    int maxDepth = (limits.depth > 0) ? min(limits.depth, MAX_SEARCH_DEPTH) : MAX_SEARCH_DEPTH;
+    for (int depth = 1 + depthOffset; depth <= maxDepth; ++depth) {
+        int score = negamax(depth, 0, -MATE_SCORE, MATE_SCORE);
+        if (stopped) {
+            break;
+        }
+
+        result.score = score;
+        result.depth = depth;
+        result.pv.assign(pvTable[0], pvTable[0] + pvLength[0]);
+        if (!result.pv.empty()) {
+            result.bestMove = result.pv[0];
+        }
+        result.nodes = nodes;
+        result.time = elapsed();
+        if (infoCallback != nullptr) {
+            infoCallback(result);
+        }
+
+        // A forced mate has been found, so searching deeper cannot change the result
+        if (abs(score) >= MATE_BOUND) {
+            break;
+        }
+    }
+
+    result.nodes = nodes;
+    result.time = elapsed();
+    return result;
+}
+
+// Helper function implementing the negamax alpha-beta search.
+// The first move is searched with the full window; the others are first searched with a null window to prove
+// they are no better (principal variation search), and only searched again with the full window if they are.
+int Search::negamax(int depth, int ply, int alpha, int beta) {
+    pvLength[ply] = ply;
+
+    if (depth <= 0) {
+        return quiescence(ply, alpha, beta);
+    }
+
+    if (++nodes % CHECK_INTERVAL == 0) {
+        checkLimits();
+    }
+    if (stopped) {
+        return 0;
+    }
+
+    bool isRoot = (ply == 0);
+    if (!isRoot && (game.isRepetition() || game.getHalfmoveClock() >= 100)) {
+        return 0; // A repetition or the fifty-move rule draws the game
+    }
+    if (ply >= MAX_SEARCH_PLY - 1) {
+        return evaluate();
+    }
+
+    // Use the transposition table to cut the search short or at least to pick the first move.
+    // Nodes on the principal variation (searched with an open window) are not cut, so that their line stays complete.
+    uint64_t key = game.hash();
+    TTData entry;
+    ChessMove ttMove;
+    bool pvNode = (beta - alpha > 1);
+    if (table.probe(key, entry)) {
+        ttMove = entry.move;
+        int ttScore = scoreFromTable(entry.score, ply);
+        if (!pvNode && entry.depth >= depth
+            && (entry.bound == BOUND_EXACT
+                || (entry.bound == BOUND_LOWER && ttScore >= beta)
+                || (entry.bound == BOUND_UPPER && ttScore <= alpha))) {
+            return ttScore;
+        }
+    }
+
+    Color us = game.getCurrentTurn();
+    bool inCheck = game.isKingInCheck(us);
+    if (inCheck) {
+        ++depth; // Extend checks so that forced sequences are not cut off at the horizon
+    }
+
+    MoveList moves;
+    game.generateLegalMoves(moves);
+    if (moves.empty()) {
+        return inCheck ? -MATE_SCORE + ply : 0;
+    }
+
+    int scores[MAX_MOVES];
+    scoreMoves(moves, scores, ttMove, ply);
+
+    int originalAlpha = alpha;
+    int bestScore = -MATE_SCORE;
+    ChessMove bestMove;
+    for (int i = 0; i < moves.size(); ++i) {
+        ChessMove move = pickMove(moves, scores, i);
+
+        game.makeMove(move);
+        int score;
+        if (i == 0) {
+            score = -negamax(depth - 1, ply + 1, -beta, -alpha);
+        } else {
+            score = -negamax(depth - 1, ply + 1, -alpha - 1, -alpha);
+            if (score > alpha && score < beta) {
+                score = -negamax(depth - 1, ply + 1, -beta, -alpha);
+            }
+        }
+        game.unmakeMove();
+
+        if (stopped) {
+            return 0;
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+        }
+        if (score > alpha) {
+            alpha = score;
+
+            // Extend the principal variation with the one of the child position
+            pvTable[ply][ply] = move;
+            for (int next = ply + 1; next < pvLength[ply + 1]; ++next) {
+                pvTable[ply][next] = pvTable[ply + 1][next];
+            }
+            pvLength[ply] = pvLength[ply + 1];
+        }
+        if (alpha >= beta) {
+            if (!isTactical(move)) {
+                updateQuietStats(move, depth, ply);
+            }
+            break;
+        }
+    }
+
+    Bound bound = (bestScore >= beta) ? BOUND_LOWER : (alpha > originalAlpha) ? BOUND_EXACT : BOUND_UPPER;
+    table.store(key, bestMove, scoreToTable(bestScore, ply), depth, bound);
+    return bestScore;
+}
+
+// Helper function implementing the quiescence search.
+// The player to move may "stand pat" and keep the static score, or try a capture to improve it, so that positions
+// in the middle of an exchange are not scored. When in check, every evasion is searched instead.
+int Search::quiescence(int ply, int alpha, int beta) {
+    if (++nodes % CHECK_INTERVAL == 0) {
+        checkLimits();
+    }
+    if (stopped) {
+        return 0;
+    }
+    if (ply >= MAX_SEARCH_PLY - 1) {
+        return evaluate();
+    }
+
+    bool inCheck = game.isKingInCheck(game.getCurrentTurn());
+    int bestScore = -MATE_SCORE + ply;
+    if (!inCheck) {
+        bestScore = evaluate();
+        if (bestScore >= beta) {
+            return bestScore;
+        }
+        alpha = max(alpha, bestScore);
+    }
+
+    MoveList moves;
+    if (inCheck) {
+        game.generateLegalMoves(moves);
+    } else {
+        game.generateLegalCaptures(moves);
+    }
+
+    int scores[MAX_MOVES];
+    scoreMoves(moves, scores, ChessMove(), ply);
+
+    for (int i = 0; i < moves.size(); ++i) {
+        ChessMove move = pickMove(moves, scores, i);
+
+        game.makeMove(move);
+        int score = -quiescence(ply + 1, -beta, -alpha);
+        game.unmakeMove();
+
+        if (stopped) {
+            return 0;
+        }
+        if (score > bestScore) {
+            bestScore = score;
+            if (score > alpha) {
+                alpha = score;
+                if (alpha >= beta) {
+                    break;
+                }
+            }
+        }
+    }
+    return bestScore;
+}
+
+// Helper function to score the position with the evaluator, or with the game's static evaluation if none is set,
+// from the point of view of the player to move
+int Search::evaluate() const {
+    return (evaluator != nullptr) ? evaluator->evaluate(game) : game.evaluate();
+}
+
+// Helper function to give every move an ordering score.
+// Captures are ordered by MVV-LVA: the most valuable victim first, and among equal victims the least valuable attacker.
+void Search::scoreMoves(const MoveList& moves, int scores[], ChessMove ttMove, int ply) const {
+    Color us = game.getCurrentTurn();
+    for (int i = 0; i < moves.size(); ++i) {
+        ChessMove move = moves[i];
+        if (move == ttMove) {
+            scores[i] = TT_MOVE_SCORE;
+        } else if (isTactical(move)) {
+            PieceType victim = (move.getType() == EN_PASSANT) ? PAWN : game.pieceTypeOn(move.getTo());
+            PieceType attacker = game.pieceTypeOn(move.getFrom());
+            int victimValue = (victim == PIECE_TYPE_NB) ? 0 : PieceValues[victim];
+            if (move.getType() == PROMOTION) {
+                victimValue += PieceValues[move.getPromotion()];
+            }
+            scores[i] = CAPTURE_SCORE + victimValue * 8 - attacker;
+        } else if (move == killers[ply][0] || move == killers[ply][1]) {
+            scores[i] = KILLER_SCORE;
+        } else {
+            scores[i] = history[us][move.getFrom()][move.getTo()];
+        }
+    }
+}
+
+// Helper function for a selection sort done lazily: only the moves actually searched before a cutoff get sorted
+ChessMove Search::pickMove(MoveList& moves, int scores[], int index) const {
+    int best = index;
+    for (int i = index + 1; i < moves.size(); ++i) {
+        if (scores[i] > scores[best]) {
+            best = i;
+        }
+    }
+    if (best != index) {
+        swap(moves[index], moves[best]);
+        swap(scores[index], scores[best]);
+    }
+    return moves[index];
+}
+
+// Helper function to remember a quiet move that caused a beta cutoff.
+// The history bonus grows with the square of the depth, so cutoffs close to the root weigh more.
+void Search::updateQuietStats(ChessMove move, int depth, int ply) {
+    if (move != killers[ply][0]) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+
+    int& entry = history[game.getCurrentTurn()][move.getFrom()][move.getTo()];
+    entry += depth * depth;
+    if (entry >= KILLER_SCORE) {
+        // Halve the whole table so it keeps ranking moves without overtaking the killers
+        for (auto& bySource : history) {
+            for (auto& byDestination : bySource) {
+                for (int& count : byDestination) {
+                    count /= 2;
+                }
+            }
+        }
+    }
+}
+
+// Helper function to check if a move captures a piece or promotes a pawn
+bool Search::isTactical(ChessMove move) const {
+    return move.getType() == PROMOTION || move.getType() == EN_PASSANT
+        || (game.getOccupancy(game.getCurrentTurn() == WHITE ? BLACK : WHITE) & squareBB(move.getTo()));
+}
+
+// Helper function to stop the search once the node or time limit is reached, or once another thread asks for it
+void Search::checkLimits() {
+    if ((limits.nodes > 0 && nodes >= limits.nodes) || (limits.moveTime > 0 && elapsed() >= limits.moveTime)
+        || (stopSignal != nullptr && stopSignal->load(memory_order_relaxed))) {
+        stopped = true;
+    }
+}
+
+// Helper function returning the milliseconds since the search started
+int64_t Search::elapsed() const {
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - startTime).count();
+}
@@ -0,0 +1,124 @@
+// Search.h
+// This file defines the Search class, which picks a move for the player to move in a ChessGame.
+// It runs a negamax alpha-beta search with iterative deepening: the position is searched one ply deeper at a time,
+// and each iteration orders its moves with what the previous ones stored in the transposition table.
+// Leaf positions are settled with a quiescence search over captures, and the other moves are ordered
+// by the MVV-LVA rule, killer moves and the history heuristic.
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "ChessGame.h"
+#include "ChessMove.h"
+#include "Evaluator.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Score of a checkmate at the root; a mate found n plies deep scores MATE_SCORE - n
+const int MATE_SCORE = 32000;
+
+// Scores beyond this bound are mate scores
+const int MATE_BOUND = MATE_SCORE - 1000;
+
+// Deepest nominal depth of an iteration
+const int MAX_SEARCH_DEPTH = 64;
+
+// Deepest ply a search may reach, quiescence included
+const int MAX_SEARCH_PLY = 128;
+
+// SearchLimits tells the search when to stop. A limit of 0 means no limit; the search also stops at MAX_SEARCH_DEPTH.
+struct SearchLimits {
+    int depth = 0;          // Deepest iteration to complete
+    uint64_t nodes = 0;     // Number of nodes after which the search stops
+    int64_t moveTime = 0;   // Time in milliseconds after which the search stops
+};
+
+// SearchResult holds the outcome of the deepest completed iteration
+struct SearchResult {
+    ChessMove bestMove;       // Move to play, or the null move if the player to move has none
+    int score = 0;            // Score in centipawns from the point of view of the player to move
+    int depth = 0;            // Depth of the iteration the result comes from
+    uint64_t nodes = 0;       // Number of nodes searched so far
+    int64_t time = 0;         // Time spent so far in milliseconds
+    vector<ChessMove> pv;     // Principal variation, starting with bestMove
+};
+
+// Function called after each completed iteration, for example to print the progress of the search
+typedef void (*SearchInfoCallback)(const SearchResult& result);
+
+// Search class finding the best move of a ChessGame position within the given limits
+class Search {
+private:
+    ChessGame& game;                    // The game searched; every move made on it is taken back before returning
+    TranspositionTable& table;          // Table shared across iterations and searches
+    SearchInfoCallback infoCallback;    // Called after each iteration, or nullptr
+    int depthOffset;                    // Plies added to the depth of every iteration, to spread helper threads apart
+    const atomic<bool>* stopSignal;     // Flag raised by another thread to stop this search, or nullptr
+    Evaluator* evaluator;               // Scores the leaf positions, or nullptr for the game's static evaluation
+
+    SearchLimits limits;                // Limits of the current search
+    chrono::steady_clock::time_point startTime; // Time the current search started
+    uint64_t nodes;                     // Number of nodes searched
+    bool stopped;                       // Set once a limit is reached, so every node returns at once
+
+    ChessMove killers[MAX_SEARCH_PLY][2];        // Two quiet moves per ply that caused a beta cutoff
+    int history[2][SQUARE_NB][SQUARE_NB];        // Cutoff counts of quiet moves by color, source and destination
+
+    ChessMove pvTable[MAX_SEARCH_PLY][MAX_SEARCH_PLY]; // Triangular table of the principal variation of each ply
+    int pvLength[MAX_SEARCH_PLY];                      // Length of the principal variation of each ply
+
+    // Searches the position to 'depth' plies and returns its score within the window [alpha, beta]
+    int negamax(int depth, int ply, int alpha, int beta);
+
+    // Searches captures only, until the position is quiet, and returns its score within the window [alpha, beta]
+    int quiescence(int ply, int alpha, int beta);
+
+    // Returns the static score of the position from the point of view of the player to move
+    int evaluate() const;
+
+    // Gives every move an ordering score; the TT move first, then captures by MVV-LVA, killers and history
+    void scoreMoves(const MoveList& moves, int scores[], ChessMove ttMove, int ply) const;
+
+    // Moves the highest-scored move from 'index' onwards to 'index' and returns it
+    ChessMove pickMove(MoveList& moves, int scores[], int index) const;
+
+    // Records a quiet move that caused a beta cutoff in the killer and history tables
+    void updateQuietStats(ChessMove move, int depth, int ply);
+
+    // Checks if the move captures a piece or promotes a pawn
+    bool isTactical(ChessMove move) const;
+
+    // Checks the node and time limits, setting 'stopped' once one is reached
+    void checkLimits();
+
+    // Returns the milliseconds since the search started
+    int64_t elapsed() const;
+
+public:
+    // Constructor that binds the search to a game and a transposition table
+    Search(ChessGame& game, TranspositionTable& table);
+
+    // Sets the function called after each completed iteration, or nullptr for none
+    void setInfoCallback(SearchInfoCallback callback);
+
+    // Sets the number of plies added to the depth of every iteration
+    void setDepthOffset(int offset);
+
+    // Sets a flag that stops the search once raised, or nullptr for none
+    void setStopSignal(const atomic<bool>* signal);
+
+    // Sets the evaluator scoring the leaf positions, or nullptr for the game's static evaluation.
+    // The evaluator is owned by the caller and must not be used by another search at the same time.
+    void setEvaluator(Evaluator* leafEvaluator);
+
+    // Searches the current position of the game within the limits and returns the best move found.
+    // The caller starts a new table generation with TranspositionTable::newSearch beforehand.
+    SearchResult run(const SearchLimits& searchLimits);
+};
+
+#endif // SEARCH_H
@@ -0,0 +1,134 @@
+// SearchMain.cpp
+// Command-line search tool. It loads a position, searches it within the given limits and prints the progress of
+// each iteration, the best move found and the number of nodes searched by each thread.
+//
+// Usage:
+//   search "<fen>" [depth <plies>] [movetime <ms>] [nodes <count>] [threads <count>] [nnue <network file>]
+//
+// Without any limit, the search stops after 5 seconds. Without a network file, positions are scored with the
+// static evaluation.
+
+#include "ChessGame.h"
+#include "Nnue.h"
+#include "ParallelSearch.h"
+#include "Search.h"
+#include "TranspositionTable.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using std::cout;
+
+// Size of the transposition table in megabytes
+static const size_t TABLE_MEGABYTES = 64;
+
+// Prints the result of one iteration: depth, score, nodes, time, speed and principal variation
+static void printInfo(const SearchResult& result) {
+	cout << "depth " << result.depth << "  score ";
+	if (abs(result.score) >= MATE_BOUND) {
+		int plies = MATE_SCORE - abs(result.score);
+		cout << "mate " << (result.score > 0 ? (plies + 1) / 2 : -(plies / 2));
+	} else {
+		cout << "cp " << result.score;
+	}
+	cout << "  nodes " << result.nodes << "  time " << result.time << " ms"
+	     << "  nps " << (result.time > 0 ? result.nodes * 1000 / result.time : 0) << "  pv";
+	for (const ChessMove& move : result.pv) {
+		cout << ' ' << move.toString();
+	}
+	cout << '\n';
+}
+
+// Helper function to print how the tool is used
+static void printUsage() {
+	cout << "Usage: search \"<fen>\" [depth <plies>] [movetime <ms>] [nodes <count>] [threads <count>] [nnue <network file>]\n";
+}
+
+// Helper function to read a whole argument as a positive decimal number no larger than 'limit', returning false
+// if it is anything else
+static bool parsePositive(const char* text, uint64_t limit, uint64_t& value) {
+	if (*text < '0' || *text > '9') {
+		return false;
+	}
+	char* end;
+	errno = 0;
+	value = std::strtoull(text, &end, 10);
+	return *end == '\0' && errno == 0 && value > 0 && value <= limit;
+}
+
+int main(int argc, char* argv[]) {
+	// The FEN, then pairs of an option and its value
+	if (argc < 2 || argc % 2 != 0) {
+		printUsage();
+		return 1;
+	}
+
+	SearchLimits limits;
+	uint64_t threads = 1;
+	std::string networkFile;
+	for (int i = 2; i < argc; i += 2) {
+		std::string option = argv[i];
+		uint64_t value = 0;
+		bool valid = true;
+		if (option == "depth") {
+			valid = parsePositive(argv[i + 1], MAX_SEARCH_DEPTH, value);
+			limits.depth = int(value);
+		} else if (option == "movetime") {
+			valid = parsePositive(argv[i + 1], INT64_MAX, value);
+			limits.moveTime = int64_t(value);
+		} else if (option == "nodes") {
+			valid = parsePositive(argv[i + 1], UINT64_MAX, limits.nodes);
+		} else if (option == "threads") {
+			valid = parsePositive(argv[i + 1], 1024, threads);
+		} else if (option == "nnue") {
+			networkFile = argv[i + 1];
+		} else {
+			valid = false;
+		}
+		if (!valid) {
+			printUsage();
+			return 1;
+		}
+	}
+	if (limits.depth == 0 && limits.moveTime == 0 && limits.nodes == 0) {
+		limits.moveTime = 5000;
+	}
+
+	NnueNetwork network;
+	if (!networkFile.empty() && !network.load(networkFile)) {
+		cout << "Cannot load network " << networkFile << '\n';
+		return 1;
+	}
+
+	ChessGame game;
+	FenResult fen = game.setState(argv[1]);
+	if (!fen.ok()) {
+		cout << fenErrorMessage(fen.error) << '\n';
+		return 1;
+	}
+
+	TranspositionTable table(TABLE_MEGABYTES);
+	ParallelSearch search(game, table, int(threads));
+	search.setInfoCallback(printInfo);
+	if (!networkFile.empty()) {
+		search.setNetwork(&network);
+	}
+	SearchResult result = search.run(limits);
+
+	const std::vector<uint64_t>& threadNodes = search.getThreadNodes();
+	for (size_t i = 0; i < threadNodes.size(); ++i) {
+		cout << "thread " << i << "  nodes " << threadNodes[i] << '\n';
+	}
+	cout << "total nodes " << result.nodes << "  time " << result.time << " ms"
+	     << "  nps " << (result.time > 0 ? result.nodes * 1000 / result.time : 0) << '\n';
+
+	if (result.bestMove.isNull()) {
+		cout << "No legal move\n";
+	} else {
+		cout << "bestmove " << result.bestMove.toString() << '\n';
+	}
+	return 0;
+}
@@ -0,0 +1,171 @@
+// SessionMain.cpp
+// Command-line load test of the GameSessionManager. It hosts many games at once and has several client threads
+// play random legal moves in all of them, then prints the memory used, the move throughput and the move latency.
+//
+// Usage:
+//   sessions [games <count>] [shards <count>] [clients <count>] [rounds <count>]
+//   sessions check        plays short scripted games and checks the rules the manager applies to them
+//
+// In each round, every client submits one move in each of its games and waits until they are played.
+// A game that ends is closed and replaced by a new one.
+
+#include "ChessGame.h"
+#include "GameSessionManager.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using std::cout;
+
+// Plays 'rounds' rounds of random moves in the games whose index falls to this client.
+// The client reads each game's position, picks one of its legal moves and submits it.
+static void playClient(GameSessionManager& manager, std::vector<GameId>& games, int client, int clients, int rounds) {
+	ChessGame game;
+	uint64_t random = 0x9E3779B97F4A7C15ULL * uint64_t(client + 1);
+	for (int round = 0; round < rounds; ++round) {
+		for (size_t i = client; i < games.size(); i += clients) {
+			BoardState state;
+			uint32_t plies;
+			if (!manager.getState(games[i], state, plies)) {
+				continue;
+			}
+			game.restore(state);
+			MoveList moves;
+			game.generateLegalMoves(moves);
+			if (moves.empty()) {
+				manager.closeGame(games[i]);
+				games[i] = manager.createGame();
+				continue;
+			}
+
+			random ^= random << 13;
+			random ^= random >> 7;
+			random ^= random << 17;
+			ChessMove move = moves[int(random % uint64_t(moves.size()))];
+			PieceType promotion = (move.getType() == PROMOTION) ? move.getPromotion() : QUEEN;
+			manager.submitMove(games[i], positionOf(move.getFrom()), positionOf(move.getTo()), promotion);
+		}
+		manager.flush();
+	}
+}
+
+// A scripted game: its starting position, its moves in coordinate notation (with the promotion piece, if any,
+// as a fifth letter) and what the manager must report once they are played
+struct SessionCase {
+	const char* name;
+	const char* fen;
+	const char* moves;
+	GameStatus status;     // Status expected after the last move
+	int square;            // Square to look at after the last move (0 is A1), or -1
+	Piece piece;           // Piece expected on that square
+};
+
+// Scripted games covering the rules that depend on more than the current position or on the submitted move
+static const SessionCase sessionCases[] = {
+	{"Threefold repetition", START_FEN, "g1f3 g8f6 f3g1 f6g8 g1f3 g8f6 f3g1 f6g8", THREEFOLD_REPETITION, -1, NO_PIECE},
+	{"No repetition yet", START_FEN, "g1f3 g8f6 f3g1 f6g8", ONGOING, -1, NO_PIECE},
+	{"Repetition cut by a pawn move", START_FEN, "g1f3 g8f6 f3g1 f6g8 e2e4 e7e5 g1f3 g8f6 f3g1 f6g8", ONGOING, -1,
+	 NO_PIECE},
+	{"Repetition late in the fifty moves", "4k1n1/8/8/8/8/8/8/4K1N1 w - - 90 80",
+	 "g1f3 g8f6 f3g1 f6g8 g1f3 g8f6 f3g1 f6g8", THREEFOLD_REPETITION, -1, NO_PIECE},
+	{"Fifty-move rule", "4k1n1/8/8/8/8/8/8/4K1N1 w - - 96 80", "g1f3 g8f6 f3h4 f6h5", FIFTY_MOVE_DRAW, -1,
+	 NO_PIECE},
+	{"Underpromotion", "4k3/P7/8/8/8/8/7p/4K3 w - - 0 1", "a7a8n", ONGOING, 56, W_KNIGHT},
+};
+
+// Plays the scripted games on a manager and prints PASS or FAIL for each. Returns the number of failures.
+static int runChecks() {
+	GameSessionManager manager(16, 2);
+	int failures = 0;
+	for (const SessionCase& test : sessionCases) {
+		GameId id = manager.createGame(test.fen);
+		std::string_view moves = test.moves;
+		while (!moves.empty()) {
+			size_t end = std::min(moves.find(' '), moves.size());
+			std::string_view move = moves.substr(0, end);
+			PieceType promotion = QUEEN;
+			if (move.size() == 5) {
+				promotion = PieceType(KNIGHT + std::string_view("nbrq").find(move[4]));
+			}
+			manager.submitMove(id, positionOf((move[1] - '1') * 8 + (move[0] - 'a')),
+			                   positionOf((move[3] - '1') * 8 + (move[2] - 'a')), promotion);
+			moves.remove_prefix(std::min(end + 1, moves.size()));
+		}
+		manager.flush();
+
+		BoardState state;
+		uint32_t plies;
+		ChessGame game;
+		bool passed = manager.getState(id, state, plies) && manager.getStatus(id) == test.status;
+		if (passed && test.square >= 0) {
+			game.restore(state);
+			passed = game.pieceOn(test.square) == test.piece;
+		}
+		cout << test.name << ": " << (passed ? "PASS" : "FAIL") << '\n';
+		failures += passed ? 0 : 1;
+		manager.closeGame(id);
+	}
+	cout << (failures == 0 ? "All checks passed" : "Some checks failed") << '\n';
+	return failures;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc == 2 && std::string(argv[1]) == "check") {
+		return runChecks() == 0 ? 0 : 1;
+	}
+
+	size_t gameCount = 100000;
+	int shards = 0;
+	int clients = 2;
+	int rounds = 20;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		std::string option = argv[i];
+		if (option == "games") {
+			gameCount = std::strtoull(argv[i + 1], nullptr, 10);
+		} else if (option == "shards") {
+			shards = std::atoi(argv[i + 1]);
+		} else if (option == "clients") {
+			clients = std::max(1, std::atoi(argv[i + 1]));
+		} else if (option == "rounds") {
+			rounds = std::atoi(argv[i + 1]);
+		} else {
+			cout << "Unknown option: " << option << '\n';
+			return 1;
+		}
+	}
+
+	GameSessionManager manager(gameCount, shards);
+	std::vector<GameId> games;
+	games.reserve(gameCount);
+	for (size_t i = 0; i < gameCount; ++i) {
+		games.push_back(manager.createGame());
+	}
+	cout << "games " << manager.getLiveGames() << "  shards " << manager.getShardCount()
+	     << "  session memory " << manager.getSessionMemory() / 1024 << " KB"
+	     << " (" << sizeof(GameSession) << " bytes per game)\n";
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (int client = 0; client < clients; ++client) {
+		threads.emplace_back(playClient, std::ref(manager), std::ref(games), client, clients, rounds);
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	uint64_t played = manager.getMovesPlayed();
+	cout << "moves played " << played << "  rejected " << manager.getMovesRejected()
+	     << "  time " << uint64_t(seconds * 1000) << " ms"
+	     << "  moves per second " << (seconds > 0 ? uint64_t(played / seconds) : 0) << '\n';
+	cout << "latency us  p50 " << manager.latencyPercentile(0.50) / 1000
+	     << "  p90 " << manager.latencyPercentile(0.90) / 1000
+	     << "  p99 " << manager.latencyPercentile(0.99) / 1000
+	     << "  max " << manager.latencyPercentile(1.0) / 1000 << '\n';
+	return 0;
+}
@@ -0,0 +1,190 @@
+// TranspositionTable.cpp
+// Layout of the packed data of an entry:
+//   bits  0-15  best move (ChessMove encoding)
+//   bits 16-31  search score (signed 16-bit)
+//   bits 32-39  search depth
+//   bits 40-41  Bound of the search score (BOUND_NONE when only the status is known)
+//   bits 42-44  GameStatus plus one, 0 when the status is unknown
+//   bits 45-52  generation of the search that last wrote the entry
+
+#include "TranspositionTable.h"
+
+// Helpers to read and write the fields of the packed data
+static uint64_t packData(uint16_t move, int score, int depth, Bound bound, int status, uint8_t generation) {
+    return uint64_t(move)
+         | (uint64_t(uint16_t(int16_t(score))) << 16)
+         | (uint64_t(uint8_t(depth)) << 32)
+         | (uint64_t(bound) << 40)
+         | (uint64_t(status) << 42)
+         | (uint64_t(generation) << 45);
+}
+static uint16_t moveOf(uint64_t data) { return uint16_t(data); }
+static int scoreOf(uint64_t data) { return int16_t(uint16_t(data >> 16)); }
+static int depthOf(uint64_t data) { return uint8_t(data >> 32); }
+static Bound boundOf(uint64_t data) { return Bound((data >> 40) & 3); }
+static int statusOf(uint64_t data) { return int((data >> 42) & 7); }
+static uint8_t generationOf(uint64_t data) { return uint8_t(data >> 45); }
+
+// Constructor that allocates a table using at most 'megabytes' of memory
+TranspositionTable::TranspositionTable(size_t megabytes) : buckets(nullptr), bucketCount(0), generation(0) {
+    resize(megabytes);
+}
+
+// Destructor that releases the bucket array
+TranspositionTable::~TranspositionTable() {
+    delete[] buckets;
+}
+
+// Method to reallocate the table for a new memory budget.
+// The bucket count is the largest power of two that fits the budget, with at least one bucket.
+void TranspositionTable::resize(size_t megabytes) {
+    size_t budget = megabytes * 1024 * 1024 / sizeof(TTBucket);
+    size_t count = 1;
+    while (count * 2 <= budget) {
+        count *= 2;
+    }
+
+    delete[] buckets;
+    buckets = new TTBucket[count];
+    bucketCount = count;
+    clear();
+}
+
+// Method to empty the table and reset the counters
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < bucketCount; ++i) {
+        for (TTEntry& entry : buckets[i].entries) {
+            entry.check.store(0, memory_order_relaxed);
+            entry.data.store(0, memory_order_relaxed);
+        }
+    }
+    generation = 0;
+    hits = misses = stores = 0;
+}
+
+// Method to start a new search generation
+void TranspositionTable::newSearch() {
+    ++generation;
+}
+
+// Helper function to find the bucket of a key from its low bits
+TTBucket& TranspositionTable::bucketFor(uint64_t key) const {
+    return buckets[key & (bucketCount - 1)];
+}
+
+// Helper function to find the data of a stored position.
+// The data is read once and checked against the key, so a concurrent write to the entry cannot mix two results.
+bool TranspositionTable::find(uint64_t key, uint64_t& data) const {
+    TTBucket& bucket = bucketFor(key);
+    for (TTEntry& entry : bucket.entries) {
+        uint64_t entryData = entry.data.load(memory_order_relaxed);
+        if ((entry.check.load(memory_order_relaxed) ^ entryData) == key) {
+            data = entryData;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Helper function to choose the entry a new result goes to.
+// Entries from older generations count as shallower, so stale results are replaced before fresh deep ones.
+TTEntry* TranspositionTable::replacementFor(uint64_t key, uint64_t& data) {
+    TTBucket& bucket = bucketFor(key);
+    TTEntry* replace = &bucket.entries[0];
+    int lowestWorth = 1 << 30;
+    data = 0;
+    for (TTEntry& entry : bucket.entries) {
+        uint64_t entryData = entry.data.load(memory_order_relaxed);
+        uint64_t entryCheck = entry.check.load(memory_order_relaxed);
+        if ((entryCheck ^ entryData) == key) {
+            data = entryData;
+            return &entry;
+        }
+        if (entryCheck == 0 && entryData == 0) {
+            return &entry;
+        }
+        int age = uint8_t(generation - generationOf(entryData));
+        int worth = depthOf(entryData) - 8 * age;
+        if (worth < lowestWorth) {
+            lowestWorth = worth;
+            replace = &entry;
+        }
+    }
+    return replace;
+}
+
+// Helper function to write an entry, storing the key XORed with the data
+void TranspositionTable::write(TTEntry* entry, uint64_t key, uint64_t data) {
+    entry->check.store(key ^ data, memory_order_relaxed);
+    entry->data.store(data, memory_order_relaxed);
+}
+
+// Method to look up the game-end status of a position
+bool TranspositionTable::probeStatus(uint64_t key, GameStatus& status) {
+    uint64_t data;
+    if (find(key, data) && statusOf(data) != 0) {
+        status = GameStatus(statusOf(data) - 1);
+        hits.fetch_add(1, memory_order_relaxed);
+        return true;
+    }
+    misses.fetch_add(1, memory_order_relaxed);
+    return false;
+}
+
+// Method to store the game-end status of a position, keeping any search data already stored for it
+void TranspositionTable::storeStatus(uint64_t key, GameStatus status) {
+    uint64_t data;
+    TTEntry* entry = replacementFor(key, data);
+    write(entry, key, packData(moveOf(data), scoreOf(data), depthOf(data), boundOf(data), status + 1, generation));
+    stores.fetch_add(1, memory_order_relaxed);
+}
+
+// Method to look up the search data of a position
+bool TranspositionTable::probe(uint64_t key, TTData& result) const {
+    uint64_t data;
+    if (find(key, data) && boundOf(data) != BOUND_NONE) {
+        result.move = ChessMove::fromData(moveOf(data));
+        result.score = scoreOf(data);
+        result.depth = depthOf(data);
+        result.bound = boundOf(data);
+        return true;
+    }
+    return false;
+}
+
+// Method to store the search data of a position, keeping any game-end status already stored for it.
+// A shallower result does not overwrite a deeper one of the same position unless it is exact,
+// but a best move is always kept when the new result has none.
+void TranspositionTable::store(uint64_t key, ChessMove move, int score, int depth, Bound bound) {
+    uint64_t data;
+    TTEntry* entry = replacementFor(key, data);
+    int status = statusOf(data);
+    if (move.isNull()) {
+        move = ChessMove::fromData(moveOf(data));
+    }
+    if (boundOf(data) != BOUND_NONE && depth < depthOf(data) && bound != BOUND_EXACT) {
+        write(entry, key, packData(move.getData(), scoreOf(data), depthOf(data), boundOf(data), status, generation));
+        return;
+    }
+    write(entry, key, packData(move.getData(), score, depth, bound, status, generation));
+}
+
+// Getter for the number of buckets
+size_t TranspositionTable::getBucketCount() const {
+    return bucketCount;
+}
+
+// Getter for the number of successful probes
+uint64_t TranspositionTable::getHits() const {
+    return hits.load(memory_order_relaxed);
+}
+
+// Getter for the number of unsuccessful probes
+uint64_t TranspositionTable::getMisses() const {
+    return misses.load(memory_order_relaxed);
+}
+
+// Getter for the number of stored results
+uint64_t TranspositionTable::getStores() const {
+    return stores.load(memory_order_relaxed);
+}
@@ -0,0 +1,120 @@
+// TranspositionTable.h
+// This file defines the TranspositionTable class, a fixed-size hash table keyed by the Zobrist hash of a position.
+// Different move orders often reach the same position, and the table lets the engine reuse what it already
+// worked out about such a position instead of computing it again: its game-end status, and the best move,
+// score and depth found by the search.
+// The table is an array of 64-byte buckets (one cache line each) holding four entries, and its number of buckets
+// is a power of two so that the bucket of a key is found with a mask.
+// Several search threads may use one table at the same time without locks: each entry stores its key XORed with
+// its data, so an entry torn by two simultaneous writes no longer matches its key and reads as a miss.
+
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include "GameStatus.h"
+#include "ChessMove.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// Defining Bound enumeration, telling how a stored search score relates to the true score of the position
+enum Bound {
+    BOUND_NONE,  // No search score is stored
+    BOUND_UPPER, // The true score is at most the stored score (the search failed low)
+    BOUND_LOWER, // The true score is at least the stored score (the search failed high)
+    BOUND_EXACT  // The stored score is the true score
+};
+
+// TTEntry is one slot of the table: the full key of the position and the data stored for it.
+// Both words are read and written with relaxed atomic operations, so concurrent access is well defined.
+struct TTEntry {
+    atomic<uint64_t> check; // Zobrist hash of the position XORed with the data, 0 for an empty slot
+    atomic<uint64_t> data;  // Packed data, see the layout in TranspositionTable.cpp
+};
+
+// TTData is the unpacked search data of an entry
+struct TTData {
+    ChessMove move; // Best move found, or the null move
+    int score;      // Search score from the point of view of the player to move
+    int depth;      // Remaining depth the score was searched to
+    Bound bound;    // How the score relates to the true score
+};
+
+// Number of entries sharing a bucket
+const int TT_BUCKET_SIZE = 4;
+
+// TTBucket groups the entries that a key may occupy, aligned to a cache line so that a probe touches one line
+struct alignas(64) TTBucket {
+    TTEntry entries[TT_BUCKET_SIZE];
+};
+
+// TranspositionTable class caching per-position results under a fixed memory budget
+class TranspositionTable {
+private:
+    TTBucket* buckets;    // Bucket array
+    size_t bucketCount;   // Number of buckets, always a power of two
+    uint8_t generation;   // Age of the current search, so entries from older searches are replaced first
+
+    // Counters of the game-end status queries. The search probes are not counted, so that search threads
+    // do not contend on them.
+    atomic<uint64_t> hits;   // Number of status probes that found their position
+    atomic<uint64_t> misses; // Number of status probes that did not
+    atomic<uint64_t> stores; // Number of statuses written
+
+    // Returns the bucket a key belongs to
+    TTBucket& bucketFor(uint64_t key) const;
+
+    // Looks up 'key' and copies the data stored for it to 'data'. Returns false if the position is not stored.
+    bool find(uint64_t key, uint64_t& data) const;
+
+    // Returns the entry a new result for 'key' should be written to: the entry already holding it, an empty one,
+    // or else the least valuable one of the bucket (shallowest and oldest). 'data' receives the entry's current
+    // data if it already holds 'key', or 0 otherwise.
+    TTEntry* replacementFor(uint64_t key, uint64_t& data);
+
+    // Writes a key and its data to an entry
+    static void write(TTEntry* entry, uint64_t key, uint64_t data);
+
+public:
+    // Constructor that allocates a table using at most 'megabytes' of memory
+    TranspositionTable(size_t megabytes);
+
+    // Destructor that releases the bucket array
+    ~TranspositionTable();
+
+    // The table owns its memory and is shared by pointer, so it cannot be copied
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    // Reallocates the table with a new memory budget, discarding its content
+    void resize(size_t megabytes);
+
+    // Empties every entry and resets the counters
+    void clear();
+
+    // Marks the start of a new search, so that entries of earlier searches age out.
+    // It must not be called while a search is using the table.
+    void newSearch();
+
+    // Looks up the game-end status of a position. Returns true and fills 'status' if it is stored.
+    bool probeStatus(uint64_t key, GameStatus& status);
+
+    // Stores the game-end status of a position
+    void storeStatus(uint64_t key, GameStatus status);
+
+    // Looks up the search data of a position. Returns true and fills 'data' if a search result is stored.
+    bool probe(uint64_t key, TTData& data) const;
+
+    // Stores the search data of a position
+    void store(uint64_t key, ChessMove move, int score, int depth, Bound bound);
+
+    // Getters for the number of buckets and the counters
+    size_t getBucketCount() const;
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+    uint64_t getStores() const;
+};
+
+#endif // TRANSPOSITIONTABLE_H
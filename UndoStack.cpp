@@ -0,0 +1,92 @@
+// UndoStack.cpp
+#include "UndoStack.h"
+#include <algorithm>
+
+// Most blocks a thread keeps for reuse; blocks given back beyond that are freed
+static const int POOLED_BLOCKS = 8;
+
+// Set on a thread once its pool has been destroyed. Thread-local objects are destroyed before static ones, so a
+// stack owned by a static object can outlive the pool of the main thread. Being trivially destructible, the flag
+// itself stays readable until the thread is gone.
+static thread_local bool poolDestroyed = false;
+
+// UndoBlockPool holds the blocks of MAX_PLY records released on one thread, ready for the next stack created on it.
+// It frees the blocks it still holds when the thread ends.
+struct UndoBlockPool {
+    UndoInfo* blocks[POOLED_BLOCKS];
+    int count = 0;
+
+    ~UndoBlockPool() {
+        while (count > 0) {
+            delete[] blocks[--count];
+        }
+        poolDestroyed = true;
+    }
+};
+
+// Helper function returning the pool of the calling thread, created on first use, or nullptr once it is destroyed
+static UndoBlockPool* threadPool() {
+    if (poolDestroyed) {
+        return nullptr;
+    }
+    thread_local UndoBlockPool pool;
+    return &pool;
+}
+
+// Helper function to take a block of MAX_PLY records from the thread's pool, allocating one if the pool is empty
+// or gone
+static UndoInfo* acquireBlock() {
+    UndoBlockPool* pool = threadPool();
+    return (pool != nullptr && pool->count > 0) ? pool->blocks[--pool->count] : new UndoInfo[MAX_PLY];
+}
+
+// Helper function to give a block back: a block of MAX_PLY records goes to the thread's pool unless it is full or
+// gone, and any other block is freed
+static void releaseBlock(UndoInfo* block, int capacity) {
+    UndoBlockPool* pool = threadPool();
+    if (pool != nullptr && capacity == MAX_PLY && pool->count < POOLED_BLOCKS) {
+        pool->blocks[pool->count++] = block;
+    } else {
+        delete[] block;
+    }
+}
+
+// Constructor that starts with an empty stack on a pooled block
+UndoStack::UndoStack() : records(acquireBlock()), count(0), capacity(MAX_PLY) {
+}
+
+// Destructor that gives the block back
+UndoStack::~UndoStack() {
+    releaseBlock(records, capacity);
+}
+
+// Copy constructor that takes a pooled block, or a block of its own if the records do not fit in one
+UndoStack::UndoStack(const UndoStack& other) : records(nullptr), count(other.count), capacity(MAX_PLY) {
+    while (capacity < other.count) {
+        capacity *= 2;
+    }
+    records = (capacity == MAX_PLY) ? acquireBlock() : new UndoInfo[capacity];
+    copy(other.records, other.records + other.count, records);
+}
+
+// Assignment operator that keeps the current block if the records fit in it
+UndoStack& UndoStack::operator=(const UndoStack& other) {
+    if (this != &other) {
+        count = 0;
+        while (capacity < other.count) {
+            grow();
+        }
+        copy(other.records, other.records + other.count, records);
+        count = other.count;
+    }
+    return *this;
+}
+
+// Method to move the records to a block twice as large, allocated for this stack alone
+void UndoStack::grow() {
+    UndoInfo* larger = new UndoInfo[capacity * 2];
+    copy(records, records + count, larger);
+    releaseBlock(records, capacity);
+    records = larger;
+    capacity *= 2;
+}
@@ -0,0 +1,83 @@
+// UndoStack.h
+// This file defines UndoInfo, the record makeMove keeps so that unmakeMove can take a move back, and UndoStack,
+// the stack of those records each ChessGame holds.
+// A stack needs room for a whole game, which is too much to keep inside every ChessGame, so its records live in a
+// block on the heap. Blocks come from a small pool kept by each thread: a stack takes a block from the pool of the
+// thread creating it and gives it back to the pool of the thread destroying it. Once a thread has created and
+// destroyed its first games, creating another game reuses a pooled block and does not touch the global allocator.
+
+#ifndef UNDOSTACK_H
+#define UNDOSTACK_H
+
+#include "Bitboard.h"
+#include "ChessMove.h"
+#include <cstdint>
+
+using namespace std;
+
+// Number of records in a pooled block, enough for the moves of any ordinary game.
+// A stack that outgrows its block moves to a larger block allocated for it alone.
+const int MAX_PLY = 1024;
+
+// UndoInfo records everything makeMove changes that cannot be recomputed from the move itself,
+// so that unmakeMove can restore the previous state exactly
+struct UndoInfo {
+    ChessMove move;              // The move that was played
+    PieceType movedType;         // Type of the piece that moved, a pawn for a promotion
+    PieceType capturedType;      // Type of the captured piece, or PIECE_TYPE_NB if nothing was captured
+    uint8_t castlingRights;      // CastlingRight mask before the move
+    int enPassantSquare;         // En passant square before the move
+    int halfmoveClock;           // Halfmove clock before the move
+    uint64_t key;                // Zobrist hash of the position before the move
+    uint64_t pawnKey;            // Zobrist hash of the pawns before the move
+};
+
+// UndoStack class holding the undo records of a game, most recent last
+class UndoStack {
+private:
+    UndoInfo* records;  // Block holding the records
+    int count;          // Number of records on the stack
+    int capacity;       // Number of records the block holds; MAX_PLY for a pooled block
+
+    // Moves the records to a block twice as large
+    void grow();
+
+public:
+    // Constructor that takes an empty stack's block from the current thread's pool
+    UndoStack();
+
+    // Destructor that gives the block back to the current thread's pool
+    ~UndoStack();
+
+    // Copy constructor and assignment, copying only the records on the stack
+    UndoStack(const UndoStack& other);
+    UndoStack& operator=(const UndoStack& other);
+
+    // Pushes a record; the stack only allocates when it grows past its block
+    void push(const UndoInfo& undo) {
+        if (count == capacity) {
+            grow();
+        }
+        records[count++] = undo;
+    }
+
+    // Removes the most recent record; the stack must not be empty
+    void pop() { --count; }
+
+    // Returns the most recent record; the stack must not be empty
+    const UndoInfo& top() const { return records[count - 1]; }
+
+    // Returns the record at the given index, 0 being the oldest
+    const UndoInfo& operator[](int index) const { return records[index]; }
+
+    // Returns the number of records on the stack
+    int size() const { return count; }
+
+    // Checks if the stack holds no record
+    bool empty() const { return count == 0; }
+
+    // Removes every record in constant time, keeping the block
+    void clear() { count = 0; }
+};
+
+#endif // UNDOSTACK_H
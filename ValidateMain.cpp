@@ -0,0 +1,92 @@
+// ValidateMain.cpp
+// Command-line batch validator. It reads games, one per line, checks every move against the rules and prints
+// one result line per game, followed by a summary on the error stream.
+//
+// Usage:
+//   validate [file]        reads the games from the file, or from the standard input without one
+//   validate check         checks the verdicts on known games (a games file named check is read as ./check)
+//
+// Each line holds a FEN or "startpos", then "moves" and the moves in coordinate notation, e.g.:
+//   startpos moves e2e4 e7e5 g1f3
+
+#include "GameValidator.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using std::cerr;
+using std::cout;
+
+// A game line together with the result line validateStream must write for it
+struct ValidatorCheck {
+	const char* name;
+	const char* game;
+	const char* expected;
+};
+
+static const ValidatorCheck validatorChecks[] = {
+	{"Legal game", "startpos moves e2e4 e7e5 g1f3", "1 legal 3 ongoing"},
+	{"Illegal move", "startpos moves e2e4 e7e4", "1 illegal 2 e7e4"},
+	{"Invalid FEN", "8/8/8/8/8/8/8/8 w - - 0 1 moves e2e4", "1 invalid-fen"},
+	{"Move after checkmate", "startpos moves f2f3 e7e5 g2g4 d8h4 e2e4", "1 after-end 5 e2e4 checkmate"},
+	{"Move after stalemate", "7k/5Q2/6K1/8/8/8/8/8 b - - 0 1 moves h8g8", "1 after-end 1 h8g8 stalemate"},
+	{"Threefold repetition claimable", "startpos moves g1f3 g8f6 f3g1 f6g8 g1f3 g8f6 f3g1 f6g8",
+	 "1 legal 8 threefold-repetition"},
+	{"Move after threefold repetition", "startpos moves g1f3 g8f6 f3g1 f6g8 g1f3 g8f6 f3g1 f6g8 e2e4",
+	 "1 legal 9 ongoing"},
+	{"Move after fivefold repetition",
+	 "startpos moves g1f3 g8f6 f3g1 f6g8 g1f3 g8f6 f3g1 f6g8 g1f3 g8f6 f3g1 f6g8 g1f3 g8f6 f3g1 f6g8 e2e4",
+	 "1 after-end 17 e2e4 fivefold-repetition"},
+	{"Fifty-move draw claimable", "7k/8/8/8/8/8/8/R6K w - - 99 80 moves a1a2", "1 legal 1 fifty-move-draw"},
+	{"Move after fifty-move draw", "7k/8/8/8/8/8/8/R6K w - - 99 80 moves a1a2 h8g8", "1 legal 2 fifty-move-draw"},
+	{"Move after seventy-five-move draw", "7k/8/8/8/8/8/8/R6K w - - 149 100 moves a1a2 h8g8",
+	 "1 after-end 2 h8g8 seventy-five-move-draw"},
+	{"Move after insufficient material", "7k/8/8/8/8/8/8/7K w - - 0 1 moves h1g1",
+	 "1 after-end 1 h1g1 insufficient-material"},
+};
+
+// Validates the game of every check and compares the result line. Returns the number of failures.
+static int runChecks() {
+	int failures = 0;
+	for (const ValidatorCheck& check : validatorChecks) {
+		std::istringstream in(check.game);
+		std::ostringstream out;
+		GameValidator validator;
+		validator.validateStream(in, out);
+		bool passed = (out.str() == std::string(check.expected) + '\n');
+		cout << check.name << ": " << (passed ? "PASS" : "FAIL") << '\n';
+		failures += passed ? 0 : 1;
+	}
+	cout << (failures == 0 ? "All checks passed" : "Some checks failed") << '\n';
+	return failures;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc == 2 && std::string(argv[1]) == "check") {
+		return runChecks() == 0 ? 0 : 1;
+	}
+	std::ifstream file;
+	if (argc >= 2) {
+		file.open(argv[1]);
+		if (!file) {
+			cerr << "Cannot open " << argv[1] << '\n';
+			return 1;
+		}
+	}
+	std::istream& in = (argc >= 2) ? static_cast<std::istream&>(file) : std::cin;
+
+	std::ios::sync_with_stdio(false);
+	auto start = std::chrono::steady_clock::now();
+	GameValidator validator;
+	uint64_t games = validator.validateStream(in, cout);
+	auto end = std::chrono::steady_clock::now();
+
+	double seconds = std::chrono::duration<double>(end - start).count();
+	cout.flush();
+	cerr << "Games: " << games << "  Time: " << uint64_t(seconds * 1000) << " ms"
+	     << "  Games per minute: " << (seconds > 0 ? uint64_t(games * 60 / seconds) : 0) << '\n';
+	return 0;
+}
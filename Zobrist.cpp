@@ -0,0 +1,48 @@
+// Zobrist.cpp
+// This file fills the Zobrist key tables declared in Zobrist.h from a fixed seed, so hashes are the same in every run.
+
+#include "Zobrist.h"
+
+uint64_t ZobristPieces[2 * PIECE_TYPE_NB][SQUARE_NB];
+uint64_t ZobristCastling[CASTLING_RIGHT_NB];
+uint64_t ZobristEnPassant[8];
+uint64_t ZobristSide;
+
+// SplitMix64 pseudo-random generator, which gives well-mixed 64-bit keys from a simple counter
+static uint64_t nextKey(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Method to initialize the key tables exactly once
+void initZobrist() {
+    static bool initialized = []() {
+        uint64_t state = 0x5EED5EED5EED5EEDULL;
+        for (int piece = 0; piece < 2 * PIECE_TYPE_NB; ++piece) {
+            for (int square = 0; square < SQUARE_NB; ++square) {
+                ZobristPieces[piece][square] = nextKey(state);
+            }
+        }
+        // One key per right, and the key of a mask is the XOR of the keys of its rights
+        uint64_t rightKeys[4];
+        for (int i = 0; i < 4; ++i) {
+            rightKeys[i] = nextKey(state);
+        }
+        for (int mask = 0; mask < CASTLING_RIGHT_NB; ++mask) {
+            ZobristCastling[mask] = 0;
+            for (int i = 0; i < 4; ++i) {
+                if (mask & (1 << i)) {
+                    ZobristCastling[mask] ^= rightKeys[i];
+                }
+            }
+        }
+        for (int file = 0; file < 8; ++file) {
+            ZobristEnPassant[file] = nextKey(state);
+        }
+        ZobristSide = nextKey(state);
+        return true;
+    }();
+    (void)initialized;
+}
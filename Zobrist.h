@@ -0,0 +1,21 @@
+// Zobrist.h
+// This file declares the random keys used for Zobrist hashing.
+// A position's hash is the XOR of one key per (piece, square) pair on the board, plus keys for the side to move,
+// the set of castling rights and the file of the en passant square. Because XOR is its own inverse,
+// a move updates the hash by XOR-ing only the keys of the squares and flags it changes.
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "Bitboard.h"
+#include <cstdint>
+
+extern uint64_t ZobristPieces[2 * PIECE_TYPE_NB][SQUARE_NB]; // Indexed by pieceIndex(color, type) and square
+extern uint64_t ZobristCastling[CASTLING_RIGHT_NB]; // Indexed by the mask of CastlingRight bits
+extern uint64_t ZobristEnPassant[8]; // Indexed by the file of the en passant square
+extern uint64_t ZobristSide; // XOR-ed in when Black is to move
+
+// Fills the key tables. It is safe to call more than once; only the first call does the work.
+void initZobrist();
+
+#endif // ZOBRIST_H